@@ -0,0 +1,31 @@
+#ifndef MAZAMAROLLUTILS_H
+#define MAZAMAROLLUTILS_H
+
+// MazamaRollUtils C++ library
+//
+// Header-only rolling window engines behind the R functions of this package.
+// They depend only on the C++ standard library and work on raw pointers, so
+// C++ code in other packages can call them directly, without R objects, by
+// adding 'LinkingTo: MazamaRollUtils' to DESCRIPTION and including this file.
+//
+//   #include <MazamaRollUtils.h>
+//
+//   MazamaRollUtils::Roll<double> roll;
+//   roll.init(x, length, 5, 1, MazamaRollUtils::ALIGN_CENTER, false);
+//   roll.mean(out);
+//
+// Roll reads double, float and int series. RollPair rolls paired double
+// series. Results are written to caller-supplied double buffers with R's
+// NA_real_ for missing values, and invalid arguments throw exceptions
+// derived from std::logic_error.
+
+#include "MazamaRollUtils/Values.h"
+#include "MazamaRollUtils/SortedWindow.h"
+#include "MazamaRollUtils/MissingIndex.h"
+#include "MazamaRollUtils/Moments.h"
+#include "MazamaRollUtils/CostModel.h"
+#include "MazamaRollUtils/RollWindow.h"
+#include "MazamaRollUtils/Roll.h"
+#include "MazamaRollUtils/RollPair.h"
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef MAZAMAROLLUTILS_COSTMODEL_H
+#define MAZAMAROLLUTILS_COSTMODEL_H
+
+namespace MazamaRollUtils {
+
+/* ----- Cost Model ----- */
+
+// Kernel choice for statistics with both a direct and an incremental kernel
+enum RollAlgorithm {
+  ALGORITHM_AUTO,
+  ALGORITHM_DIRECT,
+  ALGORITHM_INCREMENTAL
+};
+
+// Estimated costs of the rolling kernels, in nanoseconds
+//
+// The defaults were measured on a typical x86-64 machine. roll_autotune()
+// replaces them with measurements from the host. Coefficients only steer
+// the choice of kernel and never change a result.
+struct CostModel {
+
+  double window;                    // per direct window call overhead
+  double visit;                     // per value visited by a direct window
+  double select;                    // extra per value for a direct median
+  double accumulate;                // per running-sum update
+  double lookup;                    // per window of an incremental kernel
+  double update;                    // per running-moments update
+  double insert;                    // per sorted-window insertion or removal
+  double shift;                     // per element shifted in a sorted window
+
+};
+
+// Cost model shared by every Roll engine
+//
+// A function-local static gives one instance per shared library however many
+// of its translation units include this header.
+inline CostModel& costModel() {
+  static CostModel model = {
+    20.0,                           // window
+    1.5,                            // visit
+    25.0,                           // select
+    10.0,                           // accumulate
+    6.0,                            // lookup
+    20.0,                           // update
+    45.0,                           // insert
+    0.25                            // shift
+  };
+  return model;
+}
+
+} // namespace MazamaRollUtils
+
+#endif
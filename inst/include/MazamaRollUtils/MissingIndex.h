@@ -0,0 +1,69 @@
+#ifndef MAZAMAROLLUTILS_MISSINGINDEX_H
+#define MAZAMAROLLUTILS_MISSINGINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Values.h"
+
+namespace MazamaRollUtils {
+
+/* ----- Missing Value Index ----- */
+
+// Locations of missing values in a series
+//
+// Built once per series, a validity bitmap and a running count of missing
+// values let a kernel classify any window as complete, partly missing or
+// empty in O(1), and step over runs of missing values a word at a time.
+class MissingIndex {
+
+public:
+
+  template <typename T>
+  void build(const T* x, int length) {
+    count_.assign(length + 1, 0);
+    valid_.assign((length + 63) / 64, 0);
+    for (int s = 0; s < length; ++s) {
+      if (ValueTraits<T>::isMissing(x[s])) {
+        count_[s + 1] = count_[s] + 1;
+      } else {
+        count_[s + 1] = count_[s];
+        valid_[s / 64] |= static_cast<uint64_t>(1) << (s % 64);
+      }
+    }
+  }
+
+  // Number of missing values in [lo, hi)
+  int count(int lo, int hi) const {
+    return count_[hi] - count_[lo];
+  }
+
+  // First valid index in [s, hi), or 'hi' when there is none
+  int nextValid(int s, int hi) const {
+    while (s < hi) {
+      uint64_t word = valid_[s / 64] >> (s % 64);
+      if (word == 0) {
+        // Nothing valid in the rest of this word
+        s = (s / 64 + 1) * 64;
+        continue;
+      }
+      while (!(word & 1)) {
+        word >>= 1;
+        ++s;
+      }
+      return std::min(s, hi);
+    }
+    return hi;
+  }
+
+private:
+
+  std::vector<int> count_;          // missing values in [0, s)
+  std::vector<uint64_t> valid_;     // bit s set when x[s] is valid
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef MAZAMAROLLUTILS_MOMENTS_H
+#define MAZAMAROLLUTILS_MOMENTS_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Values.h"
+
+namespace MazamaRollUtils {
+
+/* ----- Running Sum ----- */
+
+// Compensated running sum of a window
+//
+// Neumaier's variant of Kahan summation carries the rounding error of every
+// addition and removal in 'compensation', so a large value that has left the
+// window does not take the small values that follow with it. Integer data
+// is summed exactly.
+//
+// The compensation is itself rounded. 'drift' bounds that error and
+// unstable() flags a total that it could have cost more than 1e-12 of its
+// value, or that has overflowed, so that the sum can be rebuilt.
+struct RunningSum {
+
+  int n;
+  double sum;                       // running total
+  double compensation;              // rounding error lost from 'sum'
+  double drift;                     // bound on the error in 'compensation'
+
+  void clear() {
+    n = 0;
+    sum = compensation = drift = 0.0;
+  }
+
+  void add(double x) {
+    n += 1;
+    accumulate(x);
+  }
+
+  // 'x' must have been added previously
+  void remove(double x) {
+    n -= 1;
+    accumulate(-x);
+  }
+
+  bool unstable() const {
+    return !std::isfinite(sum) || drift > std::fabs(total()) * 1e-12;
+  }
+
+  double total() const {
+    return sum + compensation;
+  }
+
+private:
+
+  void accumulate(double x) {
+    double t = sum + x;
+    if (std::isfinite(t)) {
+      double error = (std::fabs(sum) >= std::fabs(x)) ? (sum - t) + x : (x - t) + sum;
+      if (error != 0.0) {
+        compensation += error;
+        drift += std::fabs(compensation) * DBL_EPSILON;
+      }
+    }
+    sum = t;
+  }
+
+};
+
+/* ----- Running Moments ----- */
+
+// Running sums for a window variance
+//
+// Values are shifted by the first value added since the last clear() so the
+// sums describe the spread within the window rather than its offset from
+// zero. Integer data is summed exactly and a constant window has a variance
+// of exactly zero.
+//
+// Removing a value far from the rest, such as a spike leaving the window,
+// cancels most of 'sum_sq'. Rounding error scales with everything added and
+// removed, tracked in 'magnitude', so unstable() flags sums that must be
+// rebuilt before the variance can be trusted.
+struct Moments {
+
+  int n;
+  double shift;                     // subtracted from every value
+  long double sum;                  // sum of shifted values
+  long double sum_sq;               // sum of squared shifted values
+  long double magnitude;            // squares added or removed since clear()
+
+  void clear() {
+    n = 0;
+    shift = 0.0;
+    sum = sum_sq = magnitude = 0.0;
+  }
+
+  void add(double x) {
+    if (n == 0) {
+      shift = x;
+    }
+    long double d = x - shift;
+    n += 1;
+    sum += d;
+    sum_sq += d * d;
+    magnitude += d * d;
+  }
+
+  // 'x' must have been added previously
+  void remove(double x) {
+    long double d = x - shift;
+    n -= 1;
+    sum -= d;
+    sum_sq -= d * d;
+    magnitude += d * d;
+  }
+
+  // True when cancellation may have cost the variance its accuracy
+  //
+  // A variance below 1e-6 of 'magnitude' keeps at least about ten accurate
+  // digits even where long double is no wider than double.
+  bool unstable() const {
+    if (n < 2) {
+      return false;
+    }
+    return sum_sq - sum * sum / n < magnitude * 1e-6L;
+  }
+
+  double variance() const {
+    if (n < 2) {
+      return missingValue();
+    }
+    long double m2 = sum_sq - sum * sum / n;
+    return static_cast<double>(std::max(m2, 0.0L) / (n - 1));
+  }
+
+};
+
+/* ----- Exponentially Weighted Moments ----- */
+
+// Exponentially weighted mean and variance
+//
+// Every value enters with weight one and all weights are multiplied by a
+// decay factor as time moves on, so the state is a few numbers however long
+// the effective memory. Mean and spread are updated in the weighted form of
+// Welford's algorithm, which stays accurate when the weights become very
+// unequal. The variance is bias corrected for the effective number of
+// values, sum(w)^2 / sum(w^2).
+struct EWMoments {
+
+  int n;                            // values added
+  long double weight;               // sum of weights
+  long double weight_sq;            // sum of squared weights
+  long double mean;                 // weighted mean
+  long double m2;                   // weighted sum of squared deviations
+
+  void clear() {
+    n = 0;
+    weight = weight_sq = mean = m2 = 0.0;
+  }
+
+  // Multiply every weight by 'factor'
+  void decay(double factor) {
+    weight *= factor;
+    weight_sq *= static_cast<long double>(factor) * factor;
+    m2 *= factor;
+  }
+
+  void add(double x) {
+    long double delta = x - mean;
+    n += 1;
+    weight += 1.0;
+    weight_sq += 1.0;
+    mean += delta / weight;
+    m2 += delta * (x - mean);
+  }
+
+  double average() const {
+    if (n < 1 || weight <= 0.0) {
+      return missingValue();
+    }
+    return static_cast<double>(mean);
+  }
+
+  double variance() const {
+    if (n < 2 || weight <= 0.0) {
+      return missingValue();
+    }
+    long double effective = weight - weight_sq / weight;
+    if (effective <= 0.0) {
+      return missingValue();
+    }
+    return static_cast<double>(std::max(m2, 0.0L) / effective);
+  }
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
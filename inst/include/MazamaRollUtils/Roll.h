@@ -0,0 +1,1052 @@
+#ifndef MAZAMAROLLUTILS_ROLL_H
+#define MAZAMAROLLUTILS_ROLL_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "CostModel.h"
+#include "MissingIndex.h"
+#include "Moments.h"
+#include "RollWindow.h"
+#include "SortedWindow.h"
+#include "Values.h"
+
+namespace MazamaRollUtils {
+
+/* ----- Roll Class ----- */
+
+// Statistics available through Roll::apply()
+enum RollStatistic {
+  ROLL_COMPLETENESS,
+  ROLL_COUNT,
+  ROLL_HAMPEL,
+  ROLL_MAD,
+  ROLL_MAX,
+  ROLL_MEAN,
+  ROLL_MEDIAN,
+  ROLL_MIN,
+  ROLL_PROD,
+  ROLL_SD,
+  ROLL_SUM,
+  ROLL_VAR
+};
+
+// Rolling window engine
+//
+// Templated over the element type of 'x' (double, float or int) so that
+// data is read in place rather than converted to double. Integer series use
+// R's NA_integer_ as their missing value and floating point series use NaN.
+// Window statistics are always accumulated and returned as double.
+//
+// 'x' is not copied and must outlive the roller. Each statistic writes one
+// value per element of 'x', with NA at the edges and at positions skipped
+// over by 'by', into a caller-supplied buffer of 'length' doubles. Invalid
+// arguments throw std::invalid_argument.
+
+template <typename T>
+class Roll : public RollWindow {
+
+public:
+
+  // Initialize Roller
+  //
+  // 'weights' holds 'width' values, or is NULL for an unweighted mean.
+  void init(
+      const T* x,
+      int length,
+      int width,
+      int by,
+      RollAlign align,
+      bool na_rm,
+      const double* weights = NULL
+  ) {
+
+    initWindow(length, width, by, align, na_rm);
+
+    // Initialize private vars
+    x_ = x;
+    missing_.build(x_, length_);
+
+    // Default weights
+    weights_.assign(width_, 1.0);
+    weighted_ = (weights != NULL);
+
+    if (weighted_) {
+      for (int i = 0; i < width_; ++i) {
+        if (weights[i] < 0) {
+          throw std::invalid_argument("All 'weights' must be positive values or zero. Negative weights are not supported.");
+        };
+      }
+      // See:  https://en.cppreference.com/w/cpp/algorithm/accumulate
+      double weights_sum = std::accumulate(weights, weights + width_, (double)0);
+      if ( weights_sum == 0 ) {
+        throw std::invalid_argument("All 'weights' are zero. Please include non-zero values in 'weights'.");
+      }
+      double normalization = (double)width_ / weights_sum;
+      for (int i = 0; i < width_; ++i) {
+        weights_[i] = weights[i] * normalization;
+      }
+    }
+
+  }
+
+  // Outlier indices from a single pass over the Hampel values
+  //
+  // Tracks the largest finite Hampel value while keeping every candidate
+  // above the lowest threshold that could apply. With a data-derived
+  // threshold of max * selectivity, and max >= threshold_min required for any
+  // outliers at all, that floor is threshold_min * selectivity.
+  //
+  // Returns 0-based indices in increasing order.
+  std::vector<int> outliers(
+      double threshold_min,
+      double selectivity,
+      bool fixed_threshold
+  ) {
+    const double lowest = fixed_threshold ? threshold_min : threshold_min * selectivity;
+
+    std::vector<int> candidate_index;
+    std::vector<double> candidate_value;
+    bool found_finite = false;
+    double max_value = -std::numeric_limits<double>::infinity();
+
+    for (int i = start_; i < end_; i += by_) {
+      double h = windowHampel(i);
+      // Inf occurs when 50%+ of the window is identical and is ignored
+      if (!std::isfinite(h)) {
+        continue;
+      }
+      found_finite = true;
+      if (h > max_value) {
+        max_value = h;
+      }
+      if (h > lowest) {
+        candidate_index.push_back(i);
+        candidate_value.push_back(h);
+      }
+    }
+
+    if (!found_finite) {
+      throw std::invalid_argument("roll_hampel() returned all NA values; this can occur when 50% or more of values in every rolling window are identical.");
+    }
+
+    if (max_value < threshold_min) {
+      return std::vector<int>();
+    }
+
+    const double threshold = fixed_threshold ? threshold_min : max_value * selectivity;
+
+    int count = 0;
+    for (size_t k = 0; k < candidate_value.size(); ++k) {
+      if (candidate_value[k] > threshold) {
+        candidate_index[count++] = candidate_index[k];
+      }
+    }
+
+    candidate_index.resize(count);
+    return candidate_index;
+  }
+
+  // Rolling fraction of valid values
+  void completeness(double* out) {
+    fill(out, &Roll::windowCompleteness);
+  }
+
+  // Rolling number of valid values
+  void count(double* out) {
+    fill(out, &Roll::windowValidCount);
+  }
+
+  // Exponentially weighted mean or variance
+  //
+  // Weights halve every 'halflife' steps, or every 'halflife' units of
+  // 'times' when supplied. Missing values are not added but the decay
+  // carries on through them, so a value seen before a gap counts for less
+  // after it. Each step costs O(1) and the result at a missing value is the
+  // estimate carried over from the last valid value.
+  //
+  // 'times' holds 'length' values, or is NULL for evenly spaced steps.
+  void ewm(
+      RollStatistic statistic,
+      double halflife,
+      const double* times,
+      double* out
+  ) {
+    if (statistic != ROLL_MEAN && statistic != ROLL_VAR) {
+      throw std::invalid_argument("Statistic is not available with exponential weights");
+    }
+    if (!(halflife > 0)) {
+      throw std::invalid_argument("'halflife' must be greater than zero");
+    }
+
+    // Per-step decay when steps are evenly spaced
+    const double step_factor = std::pow(0.5, 1.0 / halflife);
+
+    EWMoments moments;
+    moments.clear();
+
+    for (int s = 0; s < length_; ++s) {
+      if (s > 0) {
+        if (times != NULL) {
+          double elapsed = times[s] - times[s - 1];
+          if (std::isnan(elapsed) || elapsed < 0) {
+            throw std::invalid_argument("'times' must be non-missing and non-decreasing");
+          }
+          moments.decay(std::pow(0.5, elapsed / halflife));
+        } else {
+          moments.decay(step_factor);
+        }
+      }
+      if (!isMissing(s)) {
+        moments.add(value(s));
+      }
+      out[s] = (statistic == ROLL_MEAN) ? moments.average() : moments.variance();
+    }
+  }
+
+  // Rolling Hampel filter
+  void hampel(double* out) {
+    fill(out, &Roll::windowHampel);
+  }
+
+  // Hampel filter with replacement
+  //
+  // Writes 'x' to 'cleaned' with every point whose Hampel value exceeds
+  // 'threshold' replaced by its window median, and sets the matching element
+  // of 'flags' to 1. Other flags are left as they are. Median and MAD come
+  // from the same window pass that decides the replacement. Returns the
+  // number of points replaced.
+  int hampelClean(
+      double threshold,
+      double* cleaned,
+      int* flags
+  ) {
+    for (int i = 0; i < length_; ++i) {
+      cleaned[i] = isMissing(i) ? missingValue() : value(i);
+    }
+
+    int replaced = 0;
+    for (int i = start_; i < end_; i += by_) {
+      if (isMissing(i)) {
+        continue;
+      }
+      double median;
+      double MAD;
+      if (!windowMedianMAD(i, median, MAD)) {
+        continue;
+      }
+      if (hampelValue(std::fabs(value(i) - median), MAD) > threshold) {
+        cleaned[i] = median;
+        flags[i] = 1;
+        replaced += 1;
+      }
+    }
+
+    return replaced;
+  }
+
+  // Rolling Median Absolute Deviation
+  void MAD(double* out) {
+    fill(out, &Roll::windowMAD);
+  }
+
+  // Rolling Maximum
+  void max(double* out) {
+    fill(out, &Roll::windowMax);
+  }
+
+  // Rolling Mean
+  void mean(double* out) {
+    fill(out, &Roll::windowMean);
+  }
+
+  // Rolling Median
+  void median(double* out) {
+    fill(out, &Roll::windowMedian);
+  }
+
+  // Rolling Minimum
+  void min(double* out) {
+    fill(out, &Roll::windowMin);
+  }
+
+  // Rolling Product
+  void prod(double* out) {
+    fill(out, &Roll::windowProd);
+  }
+
+  // Rolling Quantiles
+  //
+  // Writes one column of 'length' values per probability, column-wise, into
+  // 'out'. A single SortedWindow is carried from one window to the next,
+  // adding values that enter and removing values that leave, so every
+  // probability is read from the same sorted state.
+  void quantile(const double* probs, int n_probs, int type, double* out) {
+    for (int k = 0; k < n_probs; ++k) {
+      if (std::isnan(probs[k]) || probs[k] < 0 || probs[k] > 1) {
+        throw std::invalid_argument("'probs' must be values between 0 and 1");
+      }
+    }
+    if (type < 1 || type > 9) {
+      throw std::invalid_argument("Quantile 'type' must be an integer between 1 and 9");
+    }
+
+    std::fill(out, out + n_probs * length_, missingValue());
+
+    SortedWindow window;
+    window.reserve(width_);
+    int prev_lo = 0;
+    int prev_hi = -1;
+
+    for (int i = start_; i < end_; i += by_) {
+      int lo;
+      int hi;
+      windowBounds(i, lo, hi);
+      if (isMissingWindow(lo, hi)) {
+        continue;
+      }
+      slide(window, prev_lo, prev_hi, lo, hi);
+      for (int k = 0; k < n_probs; ++k) {
+        out[i + k * length_] = window.quantile(probs[k], type);
+      }
+    }
+  }
+
+  // Rolling statistic at several widths
+  //
+  // Writes one column of 'length' values per width, column-wise, into 'out',
+  // each filled by apply(). Every width is a separate pass; nothing is
+  // shared between widths beyond the missing value index.
+  void multiWidth(
+      const int* widths,
+      int n_widths,
+      RollStatistic statistic,
+      double* out
+  ) {
+    switch (statistic) {
+    case ROLL_MAX:
+    case ROLL_MEAN:
+    case ROLL_MEDIAN:
+    case ROLL_MIN:
+    case ROLL_SD:
+    case ROLL_SUM:
+    case ROLL_VAR:
+      break;
+    default:
+      throw std::invalid_argument("Statistic is not available at multiple widths");
+    }
+
+    const int original_width = width_;
+    const std::vector<double> original_weights = weights_;
+
+    for (int k = 0; k < n_widths; ++k) {
+      setWidth(widths[k]);
+      weights_.assign(width_, 1.0);
+      apply(statistic, out + k * length_);
+    }
+
+    setWidth(original_width);
+    weights_ = original_weights;
+  }
+
+  // Rolling Standard Deviation
+  void sd(double* out) {
+    fill(out, &Roll::windowSD);
+  }
+
+  // Rolling Sum
+  void sum(double* out) {
+    fill(out, &Roll::windowSum);
+  }
+
+  // Rolling Variance
+  void var(double* out) {
+    fill(out, &Roll::windowVar);
+  }
+
+  // Rolling statistic selected at run time
+  //
+  // Statistics with an incremental kernel use it when 'algorithm' asks for it
+  // or, by default, when the cost model expects it to be faster than the
+  // direct window*() method.
+  void apply(
+      RollStatistic statistic,
+      double* out,
+      RollAlgorithm algorithm = ALGORITHM_AUTO
+  ) {
+    if (useIncremental(statistic, algorithm)) {
+      incremental(statistic, out);
+      return;
+    }
+
+    switch (statistic) {
+    case ROLL_COMPLETENESS:
+      return completeness(out);
+    case ROLL_COUNT:
+      return count(out);
+    case ROLL_HAMPEL:
+      return hampel(out);
+    case ROLL_MAD:
+      return MAD(out);
+    case ROLL_MAX:
+      return max(out);
+    case ROLL_MEAN:
+      return mean(out);
+    case ROLL_MEDIAN:
+      return median(out);
+    case ROLL_MIN:
+      return min(out);
+    case ROLL_PROD:
+      return prod(out);
+    case ROLL_SD:
+      return sd(out);
+    case ROLL_SUM:
+      return sum(out);
+    case ROLL_VAR:
+      return var(out);
+    default:
+      throw std::logic_error("Invalid internal statistic code.");
+    }
+  }
+
+private:
+
+  const T* x_;                   // data
+  MissingIndex missing_;         // missing values in 'x_'
+  std::vector<double> weights_;  // window weights
+  bool weighted_;                // weights supplied
+  std::vector<double> values_;   // valid values of one window
+
+  // Incremental kernel state
+  RollStatistic statistic_;      // statistic being computed
+  RunningSum sum_;               // running sum of the window
+  Moments moments_;              // running moments of the window
+  SortedWindow sorted_;          // sorted values of the window
+  double probability_;           // quantile read from 'sorted_'
+  int inf_count_;                // infinite values left out of 'moments_'
+  int removed_;                  // removals since 'moments_' was rebuilt
+  int window_lo_;                // first index of the window
+  int window_hi_;                // last index of the window
+
+  typedef double (Roll::*WindowFunction)(const int &);
+
+  // Write rolling values into o[0, length_)
+  //
+  // Edges and positions skipped over by 'by_' are set to NA as we go so that
+  // each element is touched once and no pre-fill pass is needed.
+  void fill(double* o, WindowFunction window) {
+    int i = 0;
+    for (; i < start_; ++i) {
+      o[i] = missingValue();
+    }
+    while (i < end_) {
+      o[i] = (this->*window)(i);
+      int next = std::min(i + by_, end_);
+      for (++i; i < next; ++i) {
+        o[i] = missingValue();
+      }
+    }
+    for (; i < length_; ++i) {
+      o[i] = missingValue();
+    }
+  }
+
+  // Missing value test for the storage type of 'x'
+  bool isMissing(int s) const {
+    return ValueTraits<T>::isMissing(x_[s]);
+  }
+
+  // Value at index 's' promoted to double
+  double value(int s) const {
+    return static_cast<double>(x_[s]);
+  }
+
+  // True when the window [lo, hi) has an NA result
+  bool isMissingWindow(int lo, int hi) const {
+    return tooFewValid(hi - lo, missing_.count(lo, hi));
+  }
+
+  // Move a sorted window to cover [lo, hi)
+  //
+  // Valid values leaving the window are removed and those entering it are
+  // added, stepping over missing values. The window starts over when the new
+  // position does not overlap the previous one. Partial edge windows only
+  // grow at the start and shrink at the end, so they slide the same way.
+  void slide(
+      SortedWindow& window,
+      int& prev_lo,
+      int& prev_hi,
+      int lo,
+      int hi
+  ) {
+    if (lo > prev_hi) {
+      window.clear();
+      prev_lo = lo;
+      prev_hi = lo - 1;
+    }
+
+    for (int s = missing_.nextValid(prev_lo, lo); s < lo; s = missing_.nextValid(s + 1, lo)) {
+      window.remove(value(s));
+    }
+    for (int s = missing_.nextValid(prev_hi + 1, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+      window.insert(value(s));
+    }
+    prev_lo = lo;
+    prev_hi = hi - 1;
+  }
+
+  // True when 'statistic' should use its incremental kernel
+  bool useIncremental(RollStatistic statistic, RollAlgorithm algorithm) {
+    switch (statistic) {
+    case ROLL_MEAN:
+      if (weighted_) {
+        return false;
+      }
+      break;
+    case ROLL_MAX:
+    case ROLL_MEDIAN:
+    case ROLL_MIN:
+    case ROLL_SD:
+    case ROLL_SUM:
+    case ROLL_VAR:
+      break;
+    default:
+      return false;
+    }
+
+    switch (algorithm) {
+    case ALGORITHM_DIRECT:
+      return false;
+    case ALGORITHM_INCREMENTAL:
+      return true;
+    default:
+      return incrementalCost(statistic) < directCost(statistic);
+    }
+  }
+
+  // Number of windows evaluated
+  double windowCount() const {
+    return (end_ - start_ + by_ - 1) / by_;
+  }
+
+  // Estimated cost of the direct window*() method
+  //
+  // Windows that the missing value index shows to be NA are skipped without
+  // visiting any values. Without NA removal, and with missing values spread
+  // at random, a fraction (1 - p)^width of windows remain.
+  double directCost(RollStatistic statistic) const {
+    double visited = width_;
+    if (!na_rm_) {
+      double p = static_cast<double>(missing_.count(0, length_)) / length_;
+      visited *= std::pow(1.0 - p, width_);
+    }
+
+    const CostModel& model = costModel();
+    double per_window = model.window;
+    double per_value = model.visit;
+    switch (statistic) {
+    case ROLL_MEDIAN:
+      per_value += model.select;
+      break;
+    case ROLL_SD:
+    case ROLL_VAR:
+      per_value *= 2.0;
+      break;
+    default:
+      break;
+    }
+
+    return windowCount() * (per_window + visited * per_value);
+  }
+
+  // Estimated cost of the incremental kernel
+  //
+  // Overlapping windows exchange 'by_' values on each side. Windows further
+  // apart than their width are rebuilt from scratch.
+  double incrementalCost(RollStatistic statistic) const {
+    const CostModel& model = costModel();
+    const double windows = windowCount();
+    const double updates = (by_ < width_) ? 2.0 * by_ : width_;
+
+    switch (statistic) {
+    case ROLL_MEAN:
+    case ROLL_SUM:
+      return windows * (model.lookup + updates * model.accumulate);
+    case ROLL_SD:
+    case ROLL_VAR:
+      return windows * (model.lookup + updates * model.update);
+    default:
+      return windows * (model.lookup + updates *
+        (model.insert + model.shift * width_ / 2.0));
+    }
+  }
+
+  // Rolling statistic from an incremental kernel
+  //
+  // The kernels keep state from one window to the next and rely on fill()
+  // visiting windows in increasing order.
+  void incremental(RollStatistic statistic, double* out) {
+    statistic_ = statistic;
+    inf_count_ = 0;
+    removed_ = 0;
+    window_lo_ = 0;
+    window_hi_ = -1;
+
+    switch (statistic) {
+    case ROLL_MEAN:
+    case ROLL_SUM:
+      sum_.clear();
+      fill(out, &Roll::windowRunningSum);
+      break;
+    case ROLL_SD:
+    case ROLL_VAR:
+      moments_.clear();
+      fill(out, &Roll::windowMoments);
+      break;
+    default:
+      probability_ = (statistic == ROLL_MIN) ? 0.0 : (statistic == ROLL_MAX) ? 1.0 : 0.5;
+      sorted_.clear();
+      sorted_.reserve(width_);
+      fill(out, &Roll::windowSorted);
+      break;
+    }
+  }
+
+  // Window sum or mean from a running sum
+  //
+  // The sum is rebuilt when it may have lost accuracy, which only happens
+  // after cancellation, and otherwise carries on however many values have
+  // passed through. Windows with an NA result are skipped, and the next
+  // window catches up however far it has moved. Infinite values are kept
+  // out of the sum and their windows are computed directly.
+  double windowRunningSum(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+
+    if (isMissingWindow(lo, hi)) {
+      return missingValue();
+    }
+
+    if (lo > window_hi_) {
+      sum_.clear();
+      inf_count_ = 0;
+      window_lo_ = lo;
+      window_hi_ = lo - 1;
+    }
+
+    for (int s = missing_.nextValid(window_lo_, lo); s < lo; s = missing_.nextValid(s + 1, lo)) {
+      if (!std::isfinite(value(s))) {
+        inf_count_ -= 1;
+      } else {
+        sum_.remove(value(s));
+      }
+    }
+    for (int s = missing_.nextValid(window_hi_ + 1, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+      if (!std::isfinite(value(s))) {
+        inf_count_ += 1;
+      } else {
+        sum_.add(value(s));
+      }
+    }
+    window_lo_ = lo;
+    window_hi_ = hi - 1;
+
+    if (inf_count_ > 0) {
+      return (statistic_ == ROLL_MEAN) ? windowMean(index) : windowSum(index);
+    }
+
+    if (sum_.unstable()) {
+      sum_.clear();
+      for (int s = missing_.nextValid(lo, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+        sum_.add(value(s));
+      }
+    }
+
+    if (statistic_ == ROLL_MEAN) {
+      return sum_.total() / sum_.n;
+    }
+    return sum_.total();
+  }
+
+  // Window variance or standard deviation from running moments
+  //
+  // The moments are rebuilt once 'width_' values have been removed, which
+  // moves their shift to the current window and bounds rounding drift, and
+  // as soon as a removal leaves them unstable.
+  // Windows with an NA result are skipped, and the next window catches up
+  // however far it has moved. Infinite values are kept out of the moments
+  // and their windows are computed directly.
+  double windowMoments(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+
+    if (isMissingWindow(lo, hi)) {
+      return missingValue();
+    }
+
+    if (lo > window_hi_ || removed_ >= width_) {
+      moments_.clear();
+      inf_count_ = 0;
+      removed_ = 0;
+      window_lo_ = lo;
+      window_hi_ = lo - 1;
+    }
+
+    for (int s = missing_.nextValid(window_lo_, lo); s < lo; s = missing_.nextValid(s + 1, lo)) {
+      if (!std::isfinite(value(s))) {
+        inf_count_ -= 1;
+      } else {
+        moments_.remove(value(s));
+        removed_ += 1;
+      }
+    }
+    for (int s = missing_.nextValid(window_hi_ + 1, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+      if (!std::isfinite(value(s))) {
+        inf_count_ += 1;
+      } else {
+        moments_.add(value(s));
+      }
+    }
+    window_lo_ = lo;
+    window_hi_ = hi - 1;
+
+    if (moments_.unstable()) {
+      moments_.clear();
+      removed_ = 0;
+      for (int s = missing_.nextValid(lo, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+        if (std::isfinite(value(s))) {
+          moments_.add(value(s));
+        }
+      }
+    }
+
+    double variance = (inf_count_ > 0) ? windowVar(index) : moments_.variance();
+    return (statistic_ == ROLL_SD) ? std::sqrt(variance) : variance;
+  }
+
+  // Window median, minimum or maximum from a sorted window
+  double windowSorted(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+    if (isMissingWindow(lo, hi)) {
+      return missingValue();
+    }
+    slide(sorted_, window_lo_, window_hi_, lo, hi);
+    return sorted_.quantile(probability_, 7);
+  }
+
+  // Copy the valid values of a window into 'values_'
+  //
+  // Returns false when the window holds a missing value that is not being
+  // removed or too few valid values. Complete windows are copied without
+  // testing each value, and runs of missing values are stepped over using
+  // the missing value index.
+  bool collectWindowValues(const int& index, int& valid_count) {
+
+    if (static_cast<int>(values_.size()) < width_) {
+      values_.resize(width_);
+    }
+
+    valid_count = 0;
+
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+
+    int missing = missing_.count(lo, hi);
+
+    if (tooFewValid(hi - lo, missing)) {
+      return false;
+    }
+
+    if (missing == 0) {
+      for (int s = lo; s < hi; ++s) {
+        values_[valid_count++] = value(s);
+      }
+    } else {
+      for (int s = missing_.nextValid(lo, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+        values_[valid_count++] = value(s);
+      }
+    }
+
+    return true;
+  }
+
+  // Median of the first 'n' elements of 'values', reordering them
+  static double partialMedian(std::vector<double>& values, int n) {
+    int mid = n / 2;
+
+    if (n % 2 == 1) {
+      std::nth_element(values.begin(), values.begin() + mid, values.begin() + n);
+      return values[mid];
+    } else {
+      std::nth_element(values.begin(), values.begin() + mid, values.begin() + n);
+      double upper = values[mid];
+
+      std::nth_element(values.begin(), values.begin() + (mid - 1), values.begin() + n);
+      double lower = values[mid - 1];
+
+      return (lower + upper) / 2.0;
+    }
+  }
+
+  // Window median and Median Absolute Deviation from one collection pass
+  //
+  // Returns false when either is NA.
+  bool windowMedianMAD(const int &index, double& median, double& MAD) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return false;
+    }
+
+    if (valid_count == 0) {
+      return false;
+    }
+
+    median = partialMedian(values_, valid_count);
+
+    for (int i = 0; i < valid_count; ++i) {
+      values_[i] = std::fabs(values_[i] - median);
+    }
+
+    MAD = partialMedian(values_, valid_count);
+
+    return true;
+  }
+
+  // Hampel value for a deviation from the window median
+  static double hampelValue(double deviation, double MAD) {
+    const double kappa = 1.4826;
+
+    if (MAD == 0) {
+      if (deviation == 0) {
+        return 0.0;
+      } else {
+        return std::numeric_limits<double>::infinity();
+      }
+    }
+
+    return deviation / (kappa * MAD);
+  }
+
+  // Window fraction of valid values
+  double windowCompleteness(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+    return static_cast<double>((hi - lo) - missing_.count(lo, hi)) / (hi - lo);
+  }
+
+  // Window number of valid values from the missing value index
+  double windowValidCount(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+    return (hi - lo) - missing_.count(lo, hi);
+  }
+
+  // Window Hampel filter
+  double windowHampel(const int &index) {
+    if (isMissing(index)) {
+      return missingValue();
+    }
+
+    double median;
+    double MAD;
+    if (!windowMedianMAD(index, median, MAD)) {
+      return missingValue();
+    }
+
+    return hampelValue(std::fabs(value(index) - median), MAD);
+  }
+
+  // Window Median Absolute Deviation
+  double windowMAD(const int &index) {
+    double median;
+    double MAD;
+    if (!windowMedianMAD(index, median, MAD)) {
+      return missingValue();
+    }
+
+    return MAD;
+  }
+
+  // Window Maximum
+  double windowMax(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count == 0) {
+      return missingValue();
+    }
+
+    double current_max = values_[0];
+    for (int i = 1; i < valid_count; ++i) {
+      if (values_[i] > current_max) {
+        current_max = values_[i];
+      }
+    }
+
+    return current_max;
+  }
+
+  // Window Mean
+  double windowMean(const int &index) {
+    int lo;
+    int hi;
+    windowBounds(index, lo, hi);
+
+    if (isMissingWindow(lo, hi)) {
+      return missingValue();
+    }
+
+    double weighted_sum = 0.0;
+    double used_weight_sum = 0.0;
+
+    // Don't use collectWindowValues() because weights must stay aligned
+    // with the position in the full window, even when it is clipped.
+    const int first = windowIndex(index, 0);
+    if (missing_.count(lo, hi) == 0) {
+      for (int s = lo; s < hi; ++s) {
+        weighted_sum += value(s) * weights_[s - first];
+        used_weight_sum += weights_[s - first];
+      }
+    } else {
+      for (int s = missing_.nextValid(lo, hi); s < hi; s = missing_.nextValid(s + 1, hi)) {
+        weighted_sum += value(s) * weights_[s - first];
+        used_weight_sum += weights_[s - first];
+      }
+    }
+
+    if (used_weight_sum == 0.0) {
+      return missingValue();
+    }
+
+    return weighted_sum / used_weight_sum;
+  }
+
+  // Window Median
+  double windowMedian(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count == 0) {
+      return missingValue();
+    }
+
+    return partialMedian(values_, valid_count);
+  }
+
+  // Window Minimum
+  double windowMin(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count == 0) {
+      return missingValue();
+    }
+
+    double current_min = values_[0];
+    for (int i = 1; i < valid_count; ++i) {
+      if (values_[i] < current_min) {
+        current_min = values_[i];
+      }
+    }
+
+    return current_min;
+  }
+
+  // Window Product
+  double windowProd(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count == 0) {
+      return missingValue();
+    }
+
+    double product = 1.0;
+    for (int i = 0; i < valid_count; ++i) {
+      product *= values_[i];
+    }
+
+    return product;
+  }
+
+  // Window Standard Deviation
+  double windowSD(const int &index) {
+    return std::sqrt(windowVar(index));
+  }
+
+  // Window Sum
+  double windowSum(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count == 0) {
+      return missingValue();
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < valid_count; ++i) {
+      total += values_[i];
+    }
+
+    return total;
+  }
+
+  // Window Variance
+  double windowVar(const int &index) {
+    int valid_count = 0;
+
+    if (!collectWindowValues(index, valid_count)) {
+      return missingValue();
+    }
+
+    if (valid_count < 2) {
+      return missingValue();
+    }
+
+    double window_mean = 0.0;
+    for (int i = 0; i < valid_count; ++i) {
+      window_mean += values_[i];
+    }
+    window_mean /= valid_count;
+
+    double variance = 0.0;
+    for (int i = 0; i < valid_count; ++i) {
+      double deviation = values_[i] - window_mean;
+      variance += deviation * deviation;
+    }
+
+    return variance / (valid_count - 1);
+  }
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
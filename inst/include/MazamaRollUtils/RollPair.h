@@ -0,0 +1,289 @@
+#ifndef MAZAMAROLLUTILS_ROLLPAIR_H
+#define MAZAMAROLLUTILS_ROLLPAIR_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include "RollWindow.h"
+#include "Values.h"
+
+namespace MazamaRollUtils {
+
+/* ----- Roll Pair Class ----- */
+
+// Statistics available through RollPair::apply()
+enum PairStatistic {
+  PAIR_COR,
+  PAIR_COV,
+  PAIR_SLOPE
+};
+
+// Running co-moments of paired values
+//
+// Welford-style updates keep centered sums so that adding and removing pairs
+// does not suffer the cancellation of raw sums of squares and products.
+// Removing a pair far from the rest still leaves rounding residue in the
+// sums in proportion to everything added and removed, which 'scale_x' and
+// 'scale_y' track so that unstable() can call for a rebuild.
+struct CoMoments {
+
+  int n;
+  double mean_x;
+  double mean_y;
+  double m_xx;                   // sum of squared x deviations
+  double m_yy;                   // sum of squared y deviations
+  double c_xy;                   // sum of x-y deviation products
+  double scale_x;                // 'm_xx' terms added or removed
+  double scale_y;                // 'm_yy' terms added or removed
+
+  void clear() {
+    n = 0;
+    mean_x = mean_y = m_xx = m_yy = c_xy = 0.0;
+    scale_x = scale_y = 0.0;
+  }
+
+  void add(double x, double y) {
+    n += 1;
+    double dx = x - mean_x;
+    double dy = y - mean_y;
+    mean_x += dx / n;
+    mean_y += dy / n;
+    double sx = dx * (x - mean_x);
+    double sy = dy * (y - mean_y);
+    m_xx += sx;
+    m_yy += sy;
+    c_xy += dx * (y - mean_y);
+    scale_x += std::fabs(sx);
+    scale_y += std::fabs(sy);
+  }
+
+  // (x, y) must have been added previously
+  void remove(double x, double y) {
+    if (n <= 1) {
+      clear();
+      return;
+    }
+    double dx = x - mean_x;
+    double dy = y - mean_y;
+    n -= 1;
+    mean_x -= dx / n;
+    mean_y -= dy / n;
+    double sx = dx * (x - mean_x);
+    double sy = dy * (y - mean_y);
+    scale_x += std::fabs(sx);
+    scale_y += std::fabs(sy);
+    if (n == 1) {
+      // A single pair has no spread; drop any rounding residue. The means
+      // keep theirs, which the scales still account for.
+      m_xx = m_yy = c_xy = 0.0;
+      return;
+    }
+    m_xx -= sx;
+    m_yy -= sy;
+    c_xy -= dx * (y - mean_y);
+  }
+
+  // True when cancellation may have cost the sums their accuracy
+  //
+  // Only removals can leave a sum of squares small next to its scale. Sums
+  // that are not finite are always rebuilt.
+  bool unstable() const {
+    if (n < 2) {
+      return false;
+    }
+    return !(m_xx >= scale_x * 1e-6) || !(m_yy >= scale_y * 1e-6);
+  }
+
+  // True when a sum of squares is no more than rounding residue, as for a
+  // constant series
+  static bool negligible(double m, double scale) {
+    return m <= scale * 8 * DBL_EPSILON;
+  }
+
+  double statistic(PairStatistic statistic) const {
+    if (n < 2) {
+      return missingValue();
+    }
+    switch (statistic) {
+    case PAIR_COR:
+      if (negligible(m_xx, scale_x) || negligible(m_yy, scale_y)) {
+        return missingValue();
+      }
+      // Argument order lets NaN from an infinite value pass through
+      return std::max(std::min(c_xy / std::sqrt(m_xx * m_yy), 1.0), -1.0);
+    case PAIR_COV:
+      return c_xy / (n - 1);
+    case PAIR_SLOPE:
+      if (negligible(m_xx, scale_x)) {
+        return missingValue();
+      }
+      return c_xy / m_xx;
+    default:
+      throw std::logic_error("Invalid internal statistic code.");
+    }
+  }
+
+};
+
+// Rolling statistics of paired series
+//
+// 'y' holds 'columns' series of the same length as 'x', stored column-wise
+// as in an R matrix, and each column is rolled against 'x'. A pair is used
+// only when both values are present. The series are read in place and must
+// outlive the roller.
+class RollPair : public RollWindow {
+
+public:
+
+  // Initialize Roller
+  void init(
+      const double* x,
+      const double* y,
+      int length,
+      int columns,
+      int width,
+      int by,
+      RollAlign align,
+      bool na_rm
+  ) {
+
+    initWindow(length, width, by, align, na_rm);
+
+    if (columns < 1) {
+      throw std::invalid_argument("'y' must have one element, or matrix row, per element of 'x'");
+    }
+
+    x_ = x;
+    y_ = y;
+    columns_ = columns;
+
+  }
+
+  // Rolling statistic for every column of 'y'
+  //
+  // Writes 'columns' series of 'length' values, column-wise, into 'out'.
+  void apply(PairStatistic statistic, double* out) {
+    for (int k = 0; k < columns_; ++k) {
+      rollColumn(statistic, y_ + k * length_, out + k * length_);
+    }
+  }
+
+private:
+
+  const double* x_;              // reference series
+  const double* y_;              // paired series, column-wise
+  int columns_;                  // number of paired series
+
+  // Slide co-moments along one column
+  //
+  // Pairs entering the window are added and pairs leaving it are removed.
+  // The sums are rebuilt from scratch once 'width_' pairs have been removed
+  // to bound rounding drift, which keeps the cost O(1) per step amortized,
+  // and as soon as a removal leaves them unstable. Pairs with an infinite
+  // value are counted instead of added, as one would turn the running sums
+  // into NaN for good, and their windows are computed directly.
+  void rollColumn(PairStatistic statistic, const double* y, double* out) {
+    std::fill(out, out + length_, missingValue());
+
+    CoMoments moments;
+    moments.clear();
+    int na_count = 0;
+    int inf_count = 0;
+    int removed = 0;
+    int prev_lo = 0;
+    int prev_hi = -1;
+
+    for (int i = start_; i < end_; i += by_) {
+      int lo;
+      int hi;
+      windowBounds(i, lo, hi);
+
+      if (lo > prev_hi || removed >= width_) {
+        moments.clear();
+        na_count = 0;
+        inf_count = 0;
+        removed = 0;
+        prev_lo = lo;
+        prev_hi = lo - 1;
+      }
+
+      for (int s = prev_lo; s < lo; ++s) {
+        if (std::isnan(x_[s]) || std::isnan(y[s])) {
+          na_count -= 1;
+        } else if (!std::isfinite(x_[s]) || !std::isfinite(y[s])) {
+          inf_count -= 1;
+        } else {
+          moments.remove(x_[s], y[s]);
+          removed += 1;
+        }
+      }
+      for (int s = prev_hi + 1; s < hi; ++s) {
+        if (std::isnan(x_[s]) || std::isnan(y[s])) {
+          na_count += 1;
+        } else if (!std::isfinite(x_[s]) || !std::isfinite(y[s])) {
+          inf_count += 1;
+        } else {
+          moments.add(x_[s], y[s]);
+        }
+      }
+      prev_lo = lo;
+      prev_hi = hi - 1;
+
+      if (moments.unstable()) {
+        moments.clear();
+        removed = 0;
+        for (int s = lo; s < hi; ++s) {
+          if (std::isfinite(x_[s]) && std::isfinite(y[s])) {
+            moments.add(x_[s], y[s]);
+          }
+        }
+      }
+
+      if (tooFewValid(hi - lo, na_count)) {
+        continue;
+      }
+      out[i] = (inf_count > 0) ? windowStatistic(statistic, x_, y, lo, hi) : moments.statistic(statistic);
+    }
+  }
+
+  // Window statistic from the complete pairs in [lo, hi)
+  //
+  // Two passes over the window, first for the means and then for the sums
+  // of deviations, as in stats::cov(). An infinite value gives NaN.
+  static double windowStatistic(
+      PairStatistic statistic,
+      const double* x,
+      const double* y,
+      int lo,
+      int hi
+  ) {
+    CoMoments moments;
+    moments.clear();
+    for (int s = lo; s < hi; ++s) {
+      if (!std::isnan(x[s]) && !std::isnan(y[s])) {
+        moments.n += 1;
+        moments.mean_x += x[s];
+        moments.mean_y += y[s];
+      }
+    }
+    moments.mean_x /= moments.n;
+    moments.mean_y /= moments.n;
+    for (int s = lo; s < hi; ++s) {
+      if (!std::isnan(x[s]) && !std::isnan(y[s])) {
+        double dx = x[s] - moments.mean_x;
+        double dy = y[s] - moments.mean_y;
+        moments.m_xx += dx * dx;
+        moments.m_yy += dy * dy;
+        moments.c_xy += dx * dy;
+      }
+    }
+    return moments.statistic(statistic);
+  }
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef MAZAMAROLLUTILS_ROLLWINDOW_H
+#define MAZAMAROLLUTILS_ROLLWINDOW_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace MazamaRollUtils {
+
+/* ----- Roll Window ----- */
+
+// Position of each window relative to the index it is reported at
+enum RollAlign {
+  ALIGN_LEFT = -1,
+  ALIGN_CENTER = 0,
+  ALIGN_RIGHT = 1
+};
+
+// Window geometry shared by the rolling engines
+class RollWindow {
+
+public:
+
+  // Require a fraction 'min_valid' of each window to hold valid values
+  void setMinValid(double min_valid) {
+    if (!(min_valid >= 0.0 && min_valid <= 1.0)) {
+      throw std::invalid_argument("'min_valid' must be between 0 and 1");
+    }
+    min_valid_ = min_valid;
+    min_count_ = minCount(width_);
+  }
+
+  // Compute edge windows over the values available
+  void setPartial(bool partial) {
+    partial_ = partial;
+    setWidth(width_);
+  }
+
+protected:
+
+  int width_;                    // window width
+  int by_;                       // increment
+  RollAlign align_;              // alignment
+  bool na_rm_;                   // NA removal
+  int length_;                   // data length
+  int half_width_;               // window half-width
+  int start_;                    // start index
+  int end_;                      // end index
+  bool partial_;                 // edge windows cover the available range
+  double min_valid_;             // required fraction of valid values
+  int min_count_;                // required number of valid values
+
+  // Initialize window geometry for a series of length 'length'
+  void initWindow(
+      int length,
+      int width,
+      int by,
+      RollAlign align,
+      bool na_rm
+  ) {
+
+    length_ = length;
+    partial_ = false;
+    min_valid_ = 0.0;
+
+    switch (align) {
+    case ALIGN_LEFT:
+    case ALIGN_CENTER:
+    case ALIGN_RIGHT:
+      align_ = align;
+      break;
+    default:
+      throw std::invalid_argument("Window alignment 'align' must be either 'left', 'center' or 'right'");
+    }
+
+    if (by < 1) {
+      throw std::invalid_argument("Increment 'by' must be 1 or larger");
+    }
+    if (by > length) {
+      throw std::invalid_argument("Increment 'by' cannot be larger than 'x'");
+    }
+
+    by_ = by;
+
+    setWidth(width);
+
+    na_rm_ = na_rm;
+
+  }
+
+  // Change the window width, keeping length and alignment
+  void setWidth(int width) {
+
+    if (width < 1) {
+      throw std::invalid_argument("Window 'width' must be 1 or larger");
+    }
+    if (width > length_) {
+      throw std::invalid_argument("Window 'width' cannot be larger than 'x'");
+    }
+
+    width_ = width;
+    half_width_ = width / 2;   // truncated division rounds down
+    min_count_ = minCount(width_);
+
+    // Initialize start and end
+    switch (align_) {
+    case ALIGN_LEFT:
+      start_ = 0;
+      end_ = length_ - (width_ - 1);
+      break;
+    case ALIGN_CENTER:
+      start_ = half_width_;
+      end_ = length_ - (width_ - 1) + half_width_;
+      break;
+    default:
+      start_ = width_ - 1;
+      end_ = length_;
+      break;
+    }
+
+    // Partial windows extend the same 'by_' grid out to both ends
+    if (partial_) {
+      start_ = start_ % by_;
+      end_ = length_;
+    }
+
+  }
+
+  // Valid values needed for a result from 'n' values, never fewer than one
+  //
+  // The small tolerance keeps fractions such as 0.75 of 24 at exactly 18.
+  int minCount(int n) const {
+    int count = static_cast<int>(std::ceil(min_valid_ * n - 1e-9));
+    return std::max(count, 1);
+  }
+
+  // Bounds [lo, hi) of the window for 'index'
+  //
+  // Only partial edge windows are clipped to the data.
+  void windowBounds(int index, int& lo, int& hi) const {
+    lo = windowIndex(index, 0);
+    hi = lo + width_;
+    if (partial_) {
+      lo = std::max(lo, 0);
+      hi = std::min(hi, length_);
+    }
+  }
+
+  // True when a window of 'n' values with 'missing' of them missing has an
+  // NA result
+  //
+  // That is any window holding a missing value unless they are removed, and
+  // any window with too few valid values. Partial windows apply 'min_valid_'
+  // to the values available.
+  bool tooFewValid(int n, int missing) const {
+    if (missing > 0 && !na_rm_) {
+      return true;
+    }
+    int required = (n == width_) ? min_count_ : minCount(n);
+    return n - missing < required;
+  }
+
+  int windowIndex(int index, int i) const {
+    switch (align_) {
+    case ALIGN_LEFT:
+      return index + i;
+    case ALIGN_CENTER:
+      return index - half_width_ + i;
+    case ALIGN_RIGHT:
+      return index - (width_ - 1) + i;
+    default:
+      throw std::logic_error("Invalid internal alignment code.");
+    }
+  }
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
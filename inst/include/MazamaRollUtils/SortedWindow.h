@@ -0,0 +1,125 @@
+#ifndef MAZAMAROLLUTILS_SORTEDWINDOW_H
+#define MAZAMAROLLUTILS_SORTEDWINDOW_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "Values.h"
+
+namespace MazamaRollUtils {
+
+/* ----- Sorted Window ----- */
+
+// Sorted multiset of the valid values in a rolling window
+//
+// Values are kept in a contiguous sorted buffer. Insertion and removal are a
+// binary search plus a memmove, which for typical window widths beats a
+// node-based tree and leaves every order statistic available by index.
+class SortedWindow {
+
+public:
+
+  void reserve(int n) {
+    values_.reserve(n);
+  }
+
+  void clear() {
+    values_.clear();
+  }
+
+  int size() const {
+    return values_.size();
+  }
+
+  void insert(double value) {
+    values_.insert(std::upper_bound(values_.begin(), values_.end(), value), value);
+  }
+
+  // 'value' must have been inserted previously
+  void remove(double value) {
+    values_.erase(std::lower_bound(values_.begin(), values_.end(), value));
+  }
+
+  // Sample quantile matching R's quantile(x, p, type = type)
+  //
+  // See Hyndman and Fan (1996) and the source of stats::quantile.default().
+  double quantile(double p, int type) const {
+    const int n = values_.size();
+    if (n == 0) {
+      return missingValue();
+    }
+
+    if (type == 7) {
+      double index = (n - 1) * p;
+      int lo = std::floor(index);
+      int hi = std::ceil(index);
+      double q = values_[lo];
+      double h = index - lo;
+      if (h > 0 && values_[hi] != q) {
+        q = (1 - h) * q + h * values_[hi];
+      }
+      return q;
+    }
+
+    const double fuzz = 4 * DBL_EPSILON;
+    double nppm;
+    double h;
+    int j;
+
+    if (type <= 3) {
+      nppm = (type == 3) ? n * p - 0.5 : n * p;
+      j = std::floor(nppm + fuzz);
+      switch (type) {
+      case 1:
+        h = (nppm > j) ? 1.0 : 0.0;
+        break;
+      case 2:
+        h = ((nppm > j) ? 2.0 : 1.0) / 2.0;
+        break;
+      default:
+        h = (nppm != j || (j % 2) == 1) ? 1.0 : 0.0;
+        break;
+      }
+    } else {
+      double a;
+      double b;
+      switch (type) {
+      case 4: a = 0.0; b = 1.0; break;
+      case 5: a = 0.5; b = 0.5; break;
+      case 6: a = 0.0; b = 0.0; break;
+      case 8: a = 1.0 / 3.0; b = 1.0 / 3.0; break;
+      default: a = 3.0 / 8.0; b = 3.0 / 8.0; break;
+      }
+      nppm = a + p * (n + 1 - a - b);
+      j = std::floor(nppm + fuzz);
+      h = nppm - j;
+      if (std::fabs(h) < fuzz) {
+        h = 0.0;
+      }
+    }
+
+    // R pads the sorted values as c(x[1], x[1], x, x[n], x[n]) and reads
+    // positions j + 2 and j + 3 (1-based)
+    double lower = values_[std::min(std::max(j - 1, 0), n - 1)];
+    double upper = values_[std::min(std::max(j, 0), n - 1)];
+
+    if (h == 0) {
+      return lower;
+    } else if (h == 1) {
+      return upper;
+    } else {
+      return (1 - h) * lower + h * upper;
+    }
+  }
+
+private:
+
+  std::vector<double> values_;
+
+};
+
+} // namespace MazamaRollUtils
+
+#endif
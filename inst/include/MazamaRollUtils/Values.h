@@ -0,0 +1,44 @@
+#ifndef MAZAMAROLLUTILS_VALUES_H
+#define MAZAMAROLLUTILS_VALUES_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace MazamaRollUtils {
+
+/* ----- Missing Values ----- */
+
+// R's NA_real_
+//
+// A NaN with the payload R uses to tell NA from NaN, so results handed back
+// to R print as NA. Any NaN is accepted as missing on input.
+inline double missingValue() {
+  const uint64_t bits = 0x7FF00000000007A2ULL;
+  double value;
+  std::memcpy(&value, &bits, sizeof value);
+  return value;
+}
+
+// Missing value test for each supported element type
+//
+// Floating point series mark missing values with NaN. Integer series use
+// R's NA_integer_, the smallest int.
+template <typename T>
+struct ValueTraits {
+  static bool isMissing(T value) {
+    return std::isnan(value);
+  }
+};
+
+template <>
+struct ValueTraits<int> {
+  static bool isMissing(int value) {
+    return value == std::numeric_limits<int>::min();
+  }
+};
+
+} // namespace MazamaRollUtils
+
+#endif
@@ -1,624 +1,784 @@
 #include <Rcpp.h>
-#include <algorithm>
-#include <cmath>
-#include <numeric>
-
-/* ----- Roll Class ----- */
-
-class Roll {
-
-public:
-
-  // Initialize Roller
-  void init(
-      Rcpp::NumericVector x,
-      int width,
-      int by,
-      Rcpp::String const& align,
-      Rcpp::LogicalVector na_rm,
-      Rcpp::Nullable<Rcpp::NumericVector> weights
-  ) {
-
-    if (width < 1) {
-      Rcpp::stop("Window 'width' must be 1 or larger");
-    }
-    if (width > x.size()) {
-      Rcpp::stop("Window 'width' cannot be larger than 'x'");
-    }
-    if (by < 1) {
-      Rcpp::stop("Increment 'by' must be 1 or larger");
-    }
-    if (by > x.size()) {
-      Rcpp::stop("Increment 'by' cannot be larger than 'x'");
-    }
-
-    // Initialize private vars
-    x_ = x;
-    width_ = width;
-    by_ = by;
-
-    if (na_rm.size() != 1 || na_rm[0] == NA_LOGICAL) {
-      Rcpp::stop("'na_rm' must be a single TRUE or FALSE value");
-    }
-    na_rm_ = static_cast<bool>(na_rm[0]);
-
-    weights_ = Rcpp::rep(1.0, width_);
-
-    // Default weights
-    if (!weights.isNull()) {
-      // See:  https://stackoverflow.com/questions/43388698/rcpp-how-can-i-get-the-size-of-a-rcppnullable-numericvector
-      Rcpp::NumericVector w(weights.get());
-      if (w.size() != width_) {
-        Rcpp::stop("'weights' must be either NULL or a vector of the same length as the window 'width'");
-      }
-      for (int i = 0; i < width_; ++i) {
-        if (w[i] < 0) {
-          Rcpp::stop("All 'weights' must be positive values or zero. Negative weights are not supported.");
-        };
-      }
-      // See:  https://en.cppreference.com/w/cpp/algorithm/accumulate
-      double weights_sum = std::accumulate(w.begin(), w.end(), (double)0);
-      if ( weights_sum == 0 ) {
-        Rcpp::stop("All 'weights' are zero. Please include non-zero values in 'weights'.");
-      }
-      double normalization = (double)width_ / weights_sum;
-      for (int i = 0; i < width_; ++i) {
-        weights_[i] = w[i] * normalization;
-      }
-    }
-
-    // Additional private vars
-    length_ = x.size();
-    half_width_ = width / 2;   // truncated division rounds down
-
-    // Initialize start and end
-    if (align == "left") {
-      align_code_ = -1;
-      start_ = 0;
-      end_ = length_ - (width - 1);
-    } else if (align == "center") {
-      align_code_ = 0;
-      start_ = half_width_;
-      end_ = length_ - (width_ - 1) + half_width_;
-    } else if (align == "right") {
-      align_code_ = 1;
-      start_ = width - 1;
-      end_ = length_;
-    } else {
-      Rcpp::stop("Window alignment 'align' must be either 'left', 'center' or 'right'");
-    }
-
+#include <MazamaRollUtils.h>
+#include <chrono>
+#include <vector>
+
+// The rolling engines live in the header-only library under inst/include.
+// Functions here convert R arguments, allocate results and dispatch on the
+// storage type of 'x'.
+using namespace MazamaRollUtils;
+
+/* ----- Type Dispatch ----- */
+
+// Kernel choice from the 'algorithm' argument
+static RollAlgorithm algorithmCode(Rcpp::String const& algorithm) {
+  if (algorithm == "auto") {
+    return ALGORITHM_AUTO;
+  } else if (algorithm == "direct") {
+    return ALGORITHM_DIRECT;
+  } else if (algorithm == "incremental") {
+    return ALGORITHM_INCREMENTAL;
+  } else {
+    Rcpp::stop("'algorithm' must be either 'auto', 'direct' or 'incremental'");
   }
+}
 
-  // Rolling Hampel filter
-  Rcpp::NumericVector hampel() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowHampel(i);
-    }
-    return out;
-  }
-
-  // Rolling Median Absolute Deviation
-  Rcpp::NumericVector MAD() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowMAD(i);
-    }
-    return out;
+// Window alignment from the 'align' argument
+static RollAlign alignCode(Rcpp::String const& align) {
+  if (align == "left") {
+    return ALIGN_LEFT;
+  } else if (align == "center") {
+    return ALIGN_CENTER;
+  } else if (align == "right") {
+    return ALIGN_RIGHT;
+  } else {
+    Rcpp::stop("Window alignment 'align' must be either 'left', 'center' or 'right'");
   }
+}
 
-  // Rolling Maximum
-  Rcpp::NumericVector max() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowMax(i);
-    }
-    return out;
+// NA removal from the 'na_rm' argument
+static bool naRmFlag(Rcpp::LogicalVector na_rm) {
+  if (na_rm.size() != 1 || na_rm[0] == NA_LOGICAL) {
+    Rcpp::stop("'na_rm' must be a single TRUE or FALSE value");
   }
+  return static_cast<bool>(na_rm[0]);
+}
 
-  // Rolling Mean
-  Rcpp::NumericVector mean() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowMean(i);
+// Output buffer for a rolling statistic of 'x'
+//
+// Returns 'out' when supplied, after checking that it can hold one value per
+// element of 'x' starting at 'offset'. Otherwise allocates an uninitialized
+// vector because the engines write every element exactly once.
+template <int RTYPE>
+static Rcpp::NumericVector output(
+    Rcpp::Vector<RTYPE> const& x,
+    Rcpp::Nullable<Rcpp::NumericVector> out,
+    int offset
+) {
+  if (out.isNull()) {
+    if (offset != 0) {
+      Rcpp::stop("'offset' must be 0 when no 'out' buffer is supplied");
     }
-    return out;
+    return Rcpp::NumericVector(Rcpp::no_init(x.size()));
   }
-
-  // Rolling Median
-  Rcpp::NumericVector median() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowMedian(i);
-    }
-    return out;
+  Rcpp::NumericVector o(out.get());
+  if (static_cast<const void*>(o.begin()) == static_cast<const void*>(x.begin())) {
+    Rcpp::stop("'out' must not be the same object as 'x'");
   }
-
-  // Rolling Minimum
-  Rcpp::NumericVector min() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowMin(i);
-    }
-    return out;
+  if (offset < 0 || o.size() - offset < x.size()) {
+    Rcpp::stop("'out' is too short to hold the result at the requested 'offset'");
   }
+  return o;
+}
 
-  // Rolling Product
-  Rcpp::NumericVector prod() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowProd(i);
-    }
-    return out;
-  }
+template <int RTYPE>
+static Rcpp::NumericVector rollTyped(
+    RollStatistic statistic,
+    SEXP x,
+    int width,
+    int by,
+    Rcpp::String const& align,
+    Rcpp::LogicalVector na_rm,
+    Rcpp::Nullable<Rcpp::NumericVector> weights,
+    Rcpp::Nullable<Rcpp::NumericVector> out,
+    int offset,
+    RollAlgorithm algorithm,
+    double min_valid,
+    bool partial
+) {
+  typedef typename Rcpp::traits::storage_type<RTYPE>::type T;
+  Rcpp::Vector<RTYPE> v(x);
 
-  // Rolling Standard Deviation
-  Rcpp::NumericVector sd() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = sqrt(windowVar(i));
+  Rcpp::NumericVector w;
+  if (!weights.isNull()) {
+    // See:  https://stackoverflow.com/questions/43388698/rcpp-how-can-i-get-the-size-of-a-rcppnullable-numericvector
+    w = Rcpp::NumericVector(weights.get());
+    if (w.size() != width) {
+      Rcpp::stop("'weights' must be either NULL or a vector of the same length as the window 'width'");
     }
-    return out;
   }
 
-  // Rolling Sum
-  Rcpp::NumericVector sum() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowSum(i);
-    }
-    return out;
-  }
+  Roll<T> roll;
+  roll.init(v.begin(), v.size(), width, by, alignCode(align), naRmFlag(na_rm),
+            weights.isNull() ? NULL : w.begin());
+  roll.setMinValid(min_valid);
+  roll.setPartial(partial);
 
-  // Rolling Variance
-  Rcpp::NumericVector var() {
-    Rcpp::NumericVector out(length_, NA_REAL);
-    for (int i = start_; i < end_; i += by_) {
-      out[i] = windowVar(i);
-    }
-    return out;
-  }
+  Rcpp::NumericVector o = output(v, out, offset);
+  roll.apply(statistic, o.begin() + offset, algorithm);
+  return o;
+}
 
-private:
-
-  Rcpp::NumericVector x_;        // data
-  int width_;                    // window width
-  int by_;                       // increment
-  int align_code_;               // alignment
-  bool na_rm_;                   // NA removal
-  Rcpp::NumericVector weights_;  // window weights
-  int length_;                   // data length
-  int half_width_;               // window half-width
-  int start_;                    // start index
-  int end_;                      // end index
-
-  int windowIndex(int index, int i) const {
-    switch (align_code_) {
-    case -1:
-      return index + i;
-    case 0:
-      return index - half_width_ + i;
-    case 1:
-      return index - (width_ - 1) + i;
-    default:
-      Rcpp::stop("Invalid internal alignment code.");
-    }
+// Run a Roll statistic on integer or double 'x' without coercion
+static Rcpp::NumericVector rollDispatch(
+    RollStatistic statistic,
+    SEXP x,
+    int width,
+    int by,
+    Rcpp::String const& align,
+    Rcpp::LogicalVector na_rm,
+    Rcpp::Nullable<Rcpp::NumericVector> weights,
+    Rcpp::Nullable<Rcpp::NumericVector> out,
+    int offset,
+    RollAlgorithm algorithm = ALGORITHM_AUTO,
+    double min_valid = 0.0,
+    bool partial = false
+) {
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    return rollTyped<INTSXP>(statistic, x, width, by, align, na_rm, weights, out, offset, algorithm, min_valid, partial);
+  case REALSXP:
+    return rollTyped<REALSXP>(statistic, x, width, by, align, na_rm, weights, out, offset, algorithm, min_valid, partial);
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
   }
+}
 
-  bool collectWindowValues(const int& index,
-                           Rcpp::NumericVector& tmp,
-                           int& valid_count) {
-
-    valid_count = 0;
-
-    for (int i = 0; i < width_; ++i) {
-      int s = windowIndex(index, i);
+template <int RTYPE>
+static Rcpp::IntegerVector findOutliersTyped(
+    SEXP x,
+    int width,
+    double threshold_min,
+    double selectivity,
+    bool fixed_threshold
+) {
+  typedef typename Rcpp::traits::storage_type<RTYPE>::type T;
+  Rcpp::Vector<RTYPE> v(x);
 
-      if (s < 0 || s >= length_) {
-        if (!na_rm_) return false;
-      } else if (ISNAN(x_[s])) {
-        if (!na_rm_) return false;
-      } else {
-        tmp[valid_count++] = x_[s];
-      }
-    }
+  Roll<T> roll;
+  roll.init(v.begin(), v.size(), width, 1, ALIGN_CENTER, false);
+  std::vector<int> index = roll.outliers(threshold_min, selectivity, fixed_threshold);
 
-    return true;
+  // 1-based indices for use from R
+  Rcpp::IntegerVector result(Rcpp::no_init(index.size()));
+  for (size_t k = 0; k < index.size(); ++k) {
+    result[k] = index[k] + 1;
   }
+  return result;
+}
 
-  // Window Hampel filter
-  double windowHampel(const int &index) {
-    const double kappa = 1.4826;
-
-    double median = windowMedian(index);
-    if (ISNAN(median)) {
-      return NA_REAL;
-    }
-
-    double MAD = windowMAD(index);
-    if (ISNAN(MAD)) {
-      return NA_REAL;
-    }
-
-    double deviation = std::fabs(x_[index] - median);
-
-    if (MAD == 0) {
-      if (deviation == 0) {
-        return 0.0;
-      } else {
-        return R_PosInf;
-      }
-    }
-
-    return deviation / (kappa * MAD);
+// [[Rcpp::export(".findOutliers_cpp")]]
+Rcpp::IntegerVector findOutliers_cpp(
+    SEXP x,
+    int width = 25,
+    double threshold_min = 7.0,
+    double selectivity = 1.0,
+    bool fixed_threshold = true
+) {
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    return findOutliersTyped<INTSXP>(x, width, threshold_min, selectivity, fixed_threshold);
+  case REALSXP:
+    return findOutliersTyped<REALSXP>(x, width, threshold_min, selectivity, fixed_threshold);
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
   }
+}
 
-  // Window Median Absolute Deviation
-  double windowMAD(const int &index) {
-    double median = windowMedian(index);
-    if (ISNAN(median)) {
-      return NA_REAL;
-    }
-
-    int valid_count = 0;
-    Rcpp::NumericVector values(width_);
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
-
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
-
-    for (int i = 0; i < valid_count; ++i) {
-      values[i] = std::fabs(values[i] - median);
-    }
-
-    int mid = valid_count / 2;
-
-    if (valid_count % 2 == 1) {
-      std::nth_element(values.begin(), values.begin() + mid, values.begin() + valid_count);
-      return values[mid];
-    } else {
-      std::nth_element(values.begin(), values.begin() + mid, values.begin() + valid_count);
-      double upper = values[mid];
-
-      std::nth_element(values.begin(), values.begin() + (mid - 1), values.begin() + valid_count);
-      double lower = values[mid - 1];
-
-      return (lower + upper) / 2.0;
-    }
+// Nanoseconds taken by the fastest of three runs of a kernel
+static double timeKernel(
+    RollStatistic statistic,
+    Rcpp::NumericVector x,
+    int width,
+    int by,
+    RollAlgorithm algorithm
+) {
+  std::vector<double> out(x.size());
+  double best = R_PosInf;
+  for (int run = 0; run < 3; ++run) {
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Roll<double> roll;
+    roll.init(x.begin(), x.size(), width, by, ALIGN_CENTER, false);
+    roll.apply(statistic, out.data(), algorithm);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
   }
+  return best;
+}
 
-  // Window Maximum
-  double windowMax(const int &index) {
-    Rcpp::NumericVector values(width_);
-    int valid_count = 0;
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
-
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
-
-    double current_max = values[0];
-    for (int i = 1; i < valid_count; ++i) {
-      if (values[i] > current_max) {
-        current_max = values[i];
-      }
-    }
+// Cost model coefficients as a named vector
+static Rcpp::NumericVector costModelVector(CostModel const& model) {
+  return Rcpp::NumericVector::create(
+    Rcpp::Named("window") = model.window,
+    Rcpp::Named("visit") = model.visit,
+    Rcpp::Named("select") = model.select,
+    Rcpp::Named("accumulate") = model.accumulate,
+    Rcpp::Named("lookup") = model.lookup,
+    Rcpp::Named("update") = model.update,
+    Rcpp::Named("insert") = model.insert,
+    Rcpp::Named("shift") = model.shift
+  );
+}
 
-    return current_max;
+// Measure the cost model coefficients on this machine
+//
+// Each coefficient is solved from timings of the kernel it describes on
+// uniform pseudo-random data. R's random number stream is left untouched.
+// [[Rcpp::export(".roll_autotune_cpp")]]
+Rcpp::NumericVector roll_autotune_cpp(
+    int length = 65536
+) {
+  if (length < 4096) {
+    Rcpp::stop("'length' must be 4096 or larger");
   }
 
-  // Window Mean
-  double windowMean(const int &index) {
-    int na_count = 0;
-    double weighted_sum = 0.0;
-    double used_weight_sum = 0.0;
-
-    // Don't use collectWindowValues() because weights must stay aligned
-    // with the original window index 'i'.
-    for (int i = 0; i < width_; ++i) {
-      int s = windowIndex(index, i);
-
-      if (s < 0 || s >= length_) {
-        if (!na_rm_) {
-          return NA_REAL;
-        }
-        na_count += 1;
-      } else if (ISNAN(x_[s])) {
-        if (!na_rm_) {
-          return NA_REAL;
-        }
-        na_count += 1;
-      } else {
-        weighted_sum += x_[s] * weights_[i];
-        used_weight_sum += weights_[i];
-      }
-    }
-
-    if (na_count == width_) {
-      return NA_REAL;
-    }
-
-    if (used_weight_sum == 0.0) {
-      return NA_REAL;
-    }
-
-    return weighted_sum / used_weight_sum;
+  Rcpp::NumericVector x(Rcpp::no_init(length));
+  unsigned int state = 12345;
+  for (int i = 0; i < length; ++i) {
+    state = state * 1664525u + 1013904223u;
+    x[i] = state / 4294967296.0;
   }
 
-  // Window Median
-  double windowMedian(const int &index) {
-    int valid_count = 0;
-    Rcpp::NumericVector values(width_);
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
-
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
-
-    int mid = valid_count / 2;
-
-    if (valid_count % 2 == 1) {
-      std::nth_element(values.begin(), values.begin() + mid, values.begin() + valid_count);
-      return values[mid];
-    } else {
-      std::nth_element(values.begin(), values.begin() + mid, values.begin() + valid_count);
-      double upper = values[mid];
-
-      std::nth_element(values.begin(), values.begin() + (mid - 1), values.begin() + valid_count);
-      double lower = values[mid - 1];
-
-      return (lower + upper) / 2.0;
-    }
+  // Number of centered windows at 'width' and 'by'
+  struct {
+    int length;
+    double operator()(int width, int by) const {
+      return (length - width + by) / by;
+    }
+  } windows = { length };
+
+  const int width = 64;
+  const int narrow = 16;
+  const int wide = 1024;
+
+  CostModel model;
+
+  // Direct windows pay a fixed cost plus a cost per value
+  double a = timeKernel(ROLL_SUM, x, narrow, 1, ALGORITHM_DIRECT) / windows(narrow, 1);
+  double b = timeKernel(ROLL_SUM, x, width, 1, ALGORITHM_DIRECT) / windows(width, 1);
+  model.visit = (b - a) / (width - narrow);
+  model.window = a - model.visit * narrow;
+  model.select = (timeKernel(ROLL_MEDIAN, x, width, 1, ALGORITHM_DIRECT) /
+    windows(width, 1) - model.window) / width - model.visit;
+
+  // Running sums update two values per window when 'by' is 1 and rebuild
+  // from every value when windows do not overlap
+  double dense = timeKernel(ROLL_SUM, x, width, 1, ALGORITHM_INCREMENTAL) / windows(width, 1);
+  double sparse = timeKernel(ROLL_SUM, x, width, width, ALGORITHM_INCREMENTAL) / windows(width, width);
+  model.accumulate = (sparse - dense) / (width - 2);
+  model.lookup = dense - 2.0 * model.accumulate;
+
+  // One value enters and one leaves each window when 'by' is 1
+  model.update = (timeKernel(ROLL_VAR, x, width, 1, ALGORITHM_INCREMENTAL) /
+    windows(width, 1) - model.lookup) / 2.0;
+
+  // Sorted window updates grow with the number of values shifted
+  a = timeKernel(ROLL_MEDIAN, x, narrow, 1, ALGORITHM_INCREMENTAL) / windows(narrow, 1);
+  b = timeKernel(ROLL_MEDIAN, x, wide, 1, ALGORITHM_INCREMENTAL) / windows(wide, 1);
+  model.shift = (b - a) / (wide - narrow);
+  model.insert = (a - model.lookup - model.shift * narrow) / 2.0;
+
+  // Guard against timer noise producing non-positive costs
+  double* coefficient[] = {
+    &model.window, &model.visit, &model.select, &model.accumulate, &model.lookup,
+    &model.update, &model.insert, &model.shift
+  };
+  for (double* c : coefficient) {
+    *c = std::max(*c, 0.001);
   }
 
-  // Window Minimum
-  double windowMin(const int &index) {
-    Rcpp::NumericVector values(width_);
-    int valid_count = 0;
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
+  return costModelVector(model);
+}
 
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
+// [[Rcpp::export(".roll_completeness_cpp")]]
+Rcpp::NumericVector roll_completeness_cpp(
+    SEXP x,
+    int width = 5,
+    int by = 1,
+    Rcpp::String const& align = "center",
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    bool partial = false
+) {
+  Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0);
+  Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
+  return rollDispatch(ROLL_COMPLETENESS, x, width, by, align, na_rm, weights, out, offset, ALGORITHM_AUTO, 0.0, partial);
+}
 
-    double current_min = values[0];
-    for (int i = 1; i < valid_count; ++i) {
-      if (values[i] < current_min) {
-        current_min = values[i];
+// Get and optionally replace the cost model coefficients
+// [[Rcpp::export(".roll_cost_model_cpp")]]
+Rcpp::NumericVector roll_cost_model_cpp(
+    Rcpp::Nullable<Rcpp::NumericVector> coefficients = R_NilValue
+) {
+  if (!coefficients.isNull()) {
+    Rcpp::NumericVector c(coefficients.get());
+    if (c.size() != 8) {
+      Rcpp::stop("Cost model must have 8 coefficients");
+    }
+    for (int k = 0; k < c.size(); ++k) {
+      if (!R_FINITE(c[k]) || c[k] <= 0) {
+        Rcpp::stop("Cost model coefficients must be positive finite values");
       }
     }
-
-    return current_min;
+    CostModel& model = costModel();
+    model.window = c[0];
+    model.visit = c[1];
+    model.select = c[2];
+    model.accumulate = c[3];
+    model.lookup = c[4];
+    model.update = c[5];
+    model.insert = c[6];
+    model.shift = c[7];
   }
+  return costModelVector(costModel());
+}
 
-  // Window Product
-  double windowProd(const int &index) {
-    Rcpp::NumericVector values(width_);
-    int valid_count = 0;
+// [[Rcpp::export(".roll_count_cpp")]]
+Rcpp::NumericVector roll_count_cpp(
+    SEXP x,
+    int width = 5,
+    int by = 1,
+    Rcpp::String const& align = "center",
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    bool partial = false
+) {
+  Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0);
+  Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
+  return rollDispatch(ROLL_COUNT, x, width, by, align, na_rm, weights, out, offset, ALGORITHM_AUTO, 0.0, partial);
+}
 
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
+template <int RTYPE>
+static Rcpp::NumericVector rollEWMTyped(
+    RollStatistic statistic,
+    SEXP x,
+    double halflife,
+    Rcpp::Nullable<Rcpp::NumericVector> times,
+    Rcpp::Nullable<Rcpp::NumericVector> out,
+    int offset
+) {
+  typedef typename Rcpp::traits::storage_type<RTYPE>::type T;
+  Rcpp::Vector<RTYPE> v(x);
 
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
+  Roll<T> roll;
+  roll.init(v.begin(), v.size(), 1, 1, ALIGN_RIGHT, false);
 
-    double product = 1.0;
-    for (int i = 0; i < valid_count; ++i) {
-      product *= values[i];
+  Rcpp::NumericVector t;
+  if (!times.isNull()) {
+    t = Rcpp::NumericVector(times.get());
+    if (t.size() != v.size()) {
+      Rcpp::stop("'times' must have the same length as 'x'");
     }
-
-    return product;
   }
 
-  // Window Sum
-  double windowSum(const int &index) {
-    Rcpp::NumericVector values(width_);
-    int valid_count = 0;
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
-
-    if (valid_count == 0) {
-      return NA_REAL;
-    }
-
-    double total = 0.0;
-    for (int i = 0; i < valid_count; ++i) {
-      total += values[i];
-    }
+  Rcpp::NumericVector o = output(v, out, offset);
+  roll.ewm(statistic, halflife, times.isNull() ? NULL : t.begin(), o.begin() + offset);
+  return o;
+}
 
-    return total;
+// [[Rcpp::export(".roll_ewm_cpp")]]
+Rcpp::NumericVector roll_ewm_cpp(
+    SEXP x,
+    double halflife = 1.0,
+    Rcpp::Nullable<Rcpp::NumericVector> times = R_NilValue,
+    Rcpp::String const& statistic = "mean",
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0
+) {
+  RollStatistic code;
+  if (statistic == "mean") {
+    code = ROLL_MEAN;
+  } else if (statistic == "var") {
+    code = ROLL_VAR;
+  } else {
+    Rcpp::stop("Exponentially weighted 'statistic' must be either 'mean' or 'var'");
   }
 
-  // Window Variance
-  double windowVar(const int &index) {
-    Rcpp::NumericVector values(width_);
-    int valid_count = 0;
-
-    if (!collectWindowValues(index, values, valid_count)) {
-      return NA_REAL;
-    }
-
-    if (valid_count < 2) {
-      return NA_REAL;
-    }
-
-    double window_mean = 0.0;
-    for (int i = 0; i < valid_count; ++i) {
-      window_mean += values[i];
-    }
-    window_mean /= valid_count;
-
-    double variance = 0.0;
-    for (int i = 0; i < valid_count; ++i) {
-      double deviation = values[i] - window_mean;
-      variance += deviation * deviation;
-    }
-
-    return variance / (valid_count - 1);
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    return rollEWMTyped<INTSXP>(code, x, halflife, times, out, offset);
+  case REALSXP:
+    return rollEWMTyped<REALSXP>(code, x, halflife, times, out, offset);
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
   }
-
-};
+}
 
 // [[Rcpp::export(".roll_hampel_cpp")]]
 Rcpp::NumericVector roll_hampel_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.hampel();
+  return rollDispatch(ROLL_HAMPEL, x, width, by, align, na_rm, weights, out, offset, ALGORITHM_AUTO, min_valid, partial);
+}
+
+template <typename T>
+static int hampelCleanTyped(
+    const T* x,
+    int length,
+    int width,
+    RollAlign align,
+    bool na_rm,
+    double threshold,
+    Rcpp::NumericVector cleaned,
+    Rcpp::LogicalVector flags,
+    double min_valid,
+    bool partial
+) {
+  Roll<T> roll;
+  roll.init(x, length, width, 1, align, na_rm);
+  roll.setMinValid(min_valid);
+  roll.setPartial(partial);
+  return roll.hampelClean(threshold, cleaned.begin(), flags.begin());
+}
+
+// [[Rcpp::export(".roll_hampel_clean_cpp")]]
+Rcpp::List roll_hampel_clean_cpp(
+    SEXP x,
+    int width = 5,
+    Rcpp::String const& align = "center",
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    double threshold = 3.0,
+    int iterations = 1,
+    double min_valid = 0.0,
+    bool partial = false
+) {
+  if (iterations < 1) {
+    Rcpp::stop("'iterations' must be 1 or larger");
+  }
+
+  const int length = Rf_length(x);
+  const RollAlign align_code = alignCode(align);
+  const bool remove_na = naRmFlag(na_rm);
+  Rcpp::NumericVector cleaned(Rcpp::no_init(length));
+  Rcpp::LogicalVector flags(length, FALSE);
+
+  // The first pass reads 'x' in its own storage type
+  int replaced = 0;
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    replaced = hampelCleanTyped(Rcpp::IntegerVector(x).begin(), length, width, align_code,
+                                remove_na, threshold, cleaned, flags, min_valid, partial);
+    break;
+  case REALSXP:
+    replaced = hampelCleanTyped(Rcpp::NumericVector(x).begin(), length, width, align_code,
+                                remove_na, threshold, cleaned, flags, min_valid, partial);
+    break;
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
+  }
+
+  // Later passes filter the previous result until nothing changes
+  for (int k = 1; k < iterations && replaced > 0; ++k) {
+    std::vector<double> previous(cleaned.begin(), cleaned.end());
+    replaced = hampelCleanTyped(previous.data(), length, width, align_code,
+                                remove_na, threshold, cleaned, flags, min_valid, partial);
+  }
+
+  return Rcpp::List::create(
+    Rcpp::Named("x") = cleaned,
+    Rcpp::Named("outlier") = flags
+  );
 }
 
 // [[Rcpp::export(".roll_MAD_cpp")]]
 Rcpp::NumericVector roll_MAD_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.MAD();
+  return rollDispatch(ROLL_MAD, x, width, by, align, na_rm, weights, out, offset, ALGORITHM_AUTO, min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_max_cpp")]]
 Rcpp::NumericVector roll_max_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.max();
+  return rollDispatch(ROLL_MAX, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_mean_cpp")]]
 Rcpp::NumericVector roll_mean_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
     Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
-    Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue
+    Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue,
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.mean();
+  return rollDispatch(ROLL_MEAN, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_median_cpp")]]
 Rcpp::NumericVector roll_median_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.median();
+  return rollDispatch(ROLL_MEDIAN, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_min_cpp")]]
 Rcpp::NumericVector roll_min_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.min();
+  return rollDispatch(ROLL_MIN, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_prod_cpp")]]
 Rcpp::NumericVector roll_prod_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.prod();
+  return rollDispatch(ROLL_PROD, x, width, by, align, na_rm, weights, out, offset, ALGORITHM_AUTO, min_valid, partial);
+}
+
+template <int RTYPE>
+static Rcpp::NumericMatrix rollMultiWidthTyped(
+    RollStatistic statistic,
+    SEXP x,
+    Rcpp::IntegerVector widths,
+    int by,
+    Rcpp::String const& align,
+    Rcpp::LogicalVector na_rm,
+    double min_valid,
+    bool partial
+) {
+  typedef typename Rcpp::traits::storage_type<RTYPE>::type T;
+  Rcpp::Vector<RTYPE> v(x);
+  const int length = v.size();
+
+  Roll<T> roll;
+  roll.init(v.begin(), length, 1, by, alignCode(align), naRmFlag(na_rm));
+  roll.setMinValid(min_valid);
+  roll.setPartial(partial);
+
+  Rcpp::NumericMatrix out(Rcpp::no_init(length, widths.size()));
+  roll.multiWidth(widths.begin(), widths.size(), statistic, out.begin());
+  return out;
+}
+
+// [[Rcpp::export(".roll_multiwidth_cpp")]]
+Rcpp::NumericMatrix roll_multiwidth_cpp(
+    SEXP x,
+    Rcpp::IntegerVector widths = Rcpp::IntegerVector::create(5),
+    int by = 1,
+    Rcpp::String const& align = "center",
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::String const& statistic = "mean",
+    double min_valid = 0.0,
+    bool partial = false
+) {
+  RollStatistic code;
+  if (statistic == "max") {
+    code = ROLL_MAX;
+  } else if (statistic == "mean") {
+    code = ROLL_MEAN;
+  } else if (statistic == "median") {
+    code = ROLL_MEDIAN;
+  } else if (statistic == "min") {
+    code = ROLL_MIN;
+  } else if (statistic == "sd") {
+    code = ROLL_SD;
+  } else if (statistic == "sum") {
+    code = ROLL_SUM;
+  } else if (statistic == "var") {
+    code = ROLL_VAR;
+  } else {
+    Rcpp::stop("Multi-width 'statistic' must be one of 'max', 'mean', 'median', 'min', 'sd', 'sum' or 'var'");
+  }
+
+  if (widths.size() < 1) {
+    Rcpp::stop("'widths' must contain at least one window width");
+  }
+
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    return rollMultiWidthTyped<INTSXP>(code, x, widths, by, align, na_rm, min_valid, partial);
+  case REALSXP:
+    return rollMultiWidthTyped<REALSXP>(code, x, widths, by, align, na_rm, min_valid, partial);
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
+  }
+}
+
+// [[Rcpp::export(".roll_pair_cpp")]]
+Rcpp::NumericVector roll_pair_cpp(
+    Rcpp::NumericVector x,
+    Rcpp::NumericVector y,
+    int width = 5,
+    int by = 1,
+    Rcpp::String const& align = "center",
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::String const& statistic = "cor",
+    double min_valid = 0.0,
+    bool partial = false
+) {
+  PairStatistic code;
+  if (statistic == "cor") {
+    code = PAIR_COR;
+  } else if (statistic == "cov") {
+    code = PAIR_COV;
+  } else if (statistic == "slope") {
+    code = PAIR_SLOPE;
+  } else {
+    Rcpp::stop("Paired 'statistic' must be either 'cor', 'cov' or 'slope'");
+  }
+
+  if (x.size() == 0 || y.size() % x.size() != 0) {
+    Rcpp::stop("'y' must have one element, or matrix row, per element of 'x'");
+  }
+
+  RollPair roll;
+  roll.init(x.begin(), y.begin(), x.size(), y.size() / x.size(),
+            width, by, alignCode(align), naRmFlag(na_rm));
+  roll.setMinValid(min_valid);
+  roll.setPartial(partial);
+
+  Rcpp::NumericVector out(Rcpp::no_init(y.size()));
+  roll.apply(code, out.begin());
+  return out;
+}
+
+template <int RTYPE>
+static Rcpp::NumericMatrix rollQuantileTyped(
+    SEXP x,
+    int width,
+    int by,
+    Rcpp::String const& align,
+    Rcpp::LogicalVector na_rm,
+    Rcpp::NumericVector probs,
+    int type,
+    double min_valid,
+    bool partial
+) {
+  typedef typename Rcpp::traits::storage_type<RTYPE>::type T;
+  Rcpp::Vector<RTYPE> v(x);
+  const int length = v.size();
+
+  Roll<T> roll;
+  roll.init(v.begin(), length, width, by, alignCode(align), naRmFlag(na_rm));
+  roll.setMinValid(min_valid);
+  roll.setPartial(partial);
+
+  Rcpp::NumericMatrix out(Rcpp::no_init(length, probs.size()));
+  roll.quantile(probs.begin(), probs.size(), type, out.begin());
+  return out;
+}
+
+// [[Rcpp::export(".roll_quantile_cpp")]]
+Rcpp::NumericMatrix roll_quantile_cpp(
+    SEXP x,
+    int width = 5,
+    int by = 1,
+    Rcpp::String const& align = "center",
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::NumericVector probs = Rcpp::NumericVector::create(0.5),
+    int type = 7,
+    double min_valid = 0.0,
+    bool partial = false
+) {
+  switch (TYPEOF(x)) {
+  case INTSXP:
+    return rollQuantileTyped<INTSXP>(x, width, by, align, na_rm, probs, type, min_valid, partial);
+  case REALSXP:
+    return rollQuantileTyped<REALSXP>(x, width, by, align, na_rm, probs, type, min_valid, partial);
+  default:
+    Rcpp::stop("'x' must be an integer or double vector");
+  }
 }
 
 // [[Rcpp::export(".roll_sd_cpp")]]
 Rcpp::NumericVector roll_sd_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.sd();
+  return rollDispatch(ROLL_SD, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), 0.0, partial);
 }
 
 // [[Rcpp::export(".roll_sum_cpp")]]
 Rcpp::NumericVector roll_sum_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    double min_valid = 0.0,
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.sum();
+  return rollDispatch(ROLL_SUM, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), min_valid, partial);
 }
 
 // [[Rcpp::export(".roll_var_cpp")]]
 Rcpp::NumericVector roll_var_cpp(
-    Rcpp::NumericVector x,
+    SEXP x,
     int width = 5,
     int by = 1,
     Rcpp::String const& align = "center",
-    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0)
+    Rcpp::LogicalVector na_rm = Rcpp::LogicalVector::create(0),
+    Rcpp::Nullable<Rcpp::NumericVector> out = R_NilValue,
+    int offset = 0,
+    Rcpp::String const& algorithm = "auto",
+    bool partial = false
 ) {
-  Roll roll;
   Rcpp::Nullable<Rcpp::NumericVector> weights = R_NilValue;
-  roll.init(x, width, by, align, na_rm, weights);
-  return roll.var();
+  return rollDispatch(ROLL_VAR, x, width, by, align, na_rm, weights, out, offset, algorithmCode(algorithm), 0.0, partial);
 }
-
-
-
-
-
-
@@ -1,6 +1,7 @@
 // Generated by using Rcpp::compileAttributes() -> do not edit by hand
 // Generator token: 10BE3573-1514-4C36-9D1C-5A225CD40393
 
+#include "../inst/include/MazamaRollUtils.h"
 #include <Rcpp.h>
 
 using namespace Rcpp;
@@ -10,154 +11,360 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
+// findOutliers_cpp
+Rcpp::IntegerVector findOutliers_cpp(SEXP x, int width, double threshold_min, double selectivity, bool fixed_threshold);
+RcppExport SEXP _MazamaRollUtils_findOutliers_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP threshold_minSEXP, SEXP selectivitySEXP, SEXP fixed_thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold_min(threshold_minSEXP);
+    Rcpp::traits::input_parameter< double >::type selectivity(selectivitySEXP);
+    Rcpp::traits::input_parameter< bool >::type fixed_threshold(fixed_thresholdSEXP);
+    rcpp_result_gen = Rcpp::wrap(findOutliers_cpp(x, width, threshold_min, selectivity, fixed_threshold));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_autotune_cpp
+Rcpp::NumericVector roll_autotune_cpp(int length);
+RcppExport SEXP _MazamaRollUtils_roll_autotune_cpp(SEXP lengthSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type length(lengthSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_autotune_cpp(length));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_completeness_cpp
+Rcpp::NumericVector roll_completeness_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_completeness_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< int >::type by(bySEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_completeness_cpp(x, width, by, align, out, offset, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_cost_model_cpp
+Rcpp::NumericVector roll_cost_model_cpp(Rcpp::Nullable<Rcpp::NumericVector> coefficients);
+RcppExport SEXP _MazamaRollUtils_roll_cost_model_cpp(SEXP coefficientsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type coefficients(coefficientsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_cost_model_cpp(coefficients));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_count_cpp
+Rcpp::NumericVector roll_count_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_count_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< int >::type by(bySEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_count_cpp(x, width, by, align, out, offset, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_ewm_cpp
+Rcpp::NumericVector roll_ewm_cpp(SEXP x, double halflife, Rcpp::Nullable<Rcpp::NumericVector> times, Rcpp::String const& statistic, Rcpp::Nullable<Rcpp::NumericVector> out, int offset);
+RcppExport SEXP _MazamaRollUtils_roll_ewm_cpp(SEXP xSEXP, SEXP halflifeSEXP, SEXP timesSEXP, SEXP statisticSEXP, SEXP outSEXP, SEXP offsetSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< double >::type halflife(halflifeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type times(timesSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type statistic(statisticSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_ewm_cpp(x, halflife, times, statistic, out, offset));
+    return rcpp_result_gen;
+END_RCPP
+}
 // roll_hampel_cpp
-Rcpp::NumericVector roll_hampel_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_hampel_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_hampel_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_hampel_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_hampel_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_hampel_cpp(x, width, by, align, na_rm, out, offset, min_valid, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_hampel_clean_cpp
+Rcpp::List roll_hampel_clean_cpp(SEXP x, int width, Rcpp::String const& align, Rcpp::LogicalVector na_rm, double threshold, int iterations, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_hampel_clean_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP thresholdSEXP, SEXP iterationsSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type iterations(iterationsSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_hampel_clean_cpp(x, width, align, na_rm, threshold, iterations, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_MAD_cpp
-Rcpp::NumericVector roll_MAD_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_MAD_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_MAD_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_MAD_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_MAD_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_MAD_cpp(x, width, by, align, na_rm, out, offset, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_max_cpp
-Rcpp::NumericVector roll_max_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_max_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_max_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_max_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_max_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_max_cpp(x, width, by, align, na_rm, out, offset, algorithm, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_mean_cpp
-Rcpp::NumericVector roll_mean_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> weights);
-RcppExport SEXP _MazamaRollUtils_roll_mean_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP weightsSEXP) {
+Rcpp::NumericVector roll_mean_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> weights, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_mean_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP weightsSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type weights(weightsSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_mean_cpp(x, width, by, align, na_rm, weights));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_mean_cpp(x, width, by, align, na_rm, weights, out, offset, algorithm, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_median_cpp
-Rcpp::NumericVector roll_median_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_median_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_median_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_median_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_median_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_median_cpp(x, width, by, align, na_rm, out, offset, algorithm, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_min_cpp
-Rcpp::NumericVector roll_min_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_min_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_min_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_min_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_min_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_min_cpp(x, width, by, align, na_rm, out, offset, algorithm, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_prod_cpp
-Rcpp::NumericVector roll_prod_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_prod_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_prod_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_prod_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< int >::type by(bySEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_prod_cpp(x, width, by, align, na_rm, out, offset, min_valid, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_multiwidth_cpp
+Rcpp::NumericMatrix roll_multiwidth_cpp(SEXP x, Rcpp::IntegerVector widths, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::String const& statistic, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_multiwidth_cpp(SEXP xSEXP, SEXP widthsSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP statisticSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Rcpp::IntegerVector >::type widths(widthsSEXP);
+    Rcpp::traits::input_parameter< int >::type by(bySEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type statistic(statisticSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_multiwidth_cpp(x, widths, by, align, na_rm, statistic, min_valid, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_pair_cpp
+Rcpp::NumericVector roll_pair_cpp(Rcpp::NumericVector x, Rcpp::NumericVector y, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::String const& statistic, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_pair_cpp(SEXP xSEXP, SEXP ySEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP statisticSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type y(ySEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< int >::type by(bySEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
+    Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type statistic(statisticSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_pair_cpp(x, y, width, by, align, na_rm, statistic, min_valid, partial));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_quantile_cpp
+Rcpp::NumericMatrix roll_quantile_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::NumericVector probs, int type, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_quantile_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP probsSEXP, SEXP typeSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_prod_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type probs(probsSEXP);
+    Rcpp::traits::input_parameter< int >::type type(typeSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_quantile_cpp(x, width, by, align, na_rm, probs, type, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_sd_cpp
-Rcpp::NumericVector roll_sd_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_sd_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_sd_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_sd_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_sd_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_sd_cpp(x, width, by, align, na_rm, out, offset, algorithm, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_sum_cpp
-Rcpp::NumericVector roll_sum_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_sum_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_sum_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, double min_valid, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_sum_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP min_validSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_sum_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< double >::type min_valid(min_validSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_sum_cpp(x, width, by, align, na_rm, out, offset, algorithm, min_valid, partial));
     return rcpp_result_gen;
 END_RCPP
 }
 // roll_var_cpp
-Rcpp::NumericVector roll_var_cpp(Rcpp::NumericVector x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm);
-RcppExport SEXP _MazamaRollUtils_roll_var_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP) {
+Rcpp::NumericVector roll_var_cpp(SEXP x, int width, int by, Rcpp::String const& align, Rcpp::LogicalVector na_rm, Rcpp::Nullable<Rcpp::NumericVector> out, int offset, Rcpp::String const& algorithm, bool partial);
+RcppExport SEXP _MazamaRollUtils_roll_var_cpp(SEXP xSEXP, SEXP widthSEXP, SEXP bySEXP, SEXP alignSEXP, SEXP na_rmSEXP, SEXP outSEXP, SEXP offsetSEXP, SEXP algorithmSEXP, SEXP partialSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type by(bySEXP);
     Rcpp::traits::input_parameter< Rcpp::String const& >::type align(alignSEXP);
     Rcpp::traits::input_parameter< Rcpp::LogicalVector >::type na_rm(na_rmSEXP);
-    rcpp_result_gen = Rcpp::wrap(roll_var_cpp(x, width, by, align, na_rm));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type out(outSEXP);
+    Rcpp::traits::input_parameter< int >::type offset(offsetSEXP);
+    Rcpp::traits::input_parameter< Rcpp::String const& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< bool >::type partial(partialSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_var_cpp(x, width, by, align, na_rm, out, offset, algorithm, partial));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -174,16 +381,26 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_MazamaRollUtils_roll_hampel_cpp", (DL_FUNC) &_MazamaRollUtils_roll_hampel_cpp, 5},
-    {"_MazamaRollUtils_roll_MAD_cpp", (DL_FUNC) &_MazamaRollUtils_roll_MAD_cpp, 5},
-    {"_MazamaRollUtils_roll_max_cpp", (DL_FUNC) &_MazamaRollUtils_roll_max_cpp, 5},
-    {"_MazamaRollUtils_roll_mean_cpp", (DL_FUNC) &_MazamaRollUtils_roll_mean_cpp, 6},
-    {"_MazamaRollUtils_roll_median_cpp", (DL_FUNC) &_MazamaRollUtils_roll_median_cpp, 5},
-    {"_MazamaRollUtils_roll_min_cpp", (DL_FUNC) &_MazamaRollUtils_roll_min_cpp, 5},
-    {"_MazamaRollUtils_roll_prod_cpp", (DL_FUNC) &_MazamaRollUtils_roll_prod_cpp, 5},
-    {"_MazamaRollUtils_roll_sd_cpp", (DL_FUNC) &_MazamaRollUtils_roll_sd_cpp, 5},
-    {"_MazamaRollUtils_roll_sum_cpp", (DL_FUNC) &_MazamaRollUtils_roll_sum_cpp, 5},
-    {"_MazamaRollUtils_roll_var_cpp", (DL_FUNC) &_MazamaRollUtils_roll_var_cpp, 5},
+    {"_MazamaRollUtils_findOutliers_cpp", (DL_FUNC) &_MazamaRollUtils_findOutliers_cpp, 5},
+    {"_MazamaRollUtils_roll_autotune_cpp", (DL_FUNC) &_MazamaRollUtils_roll_autotune_cpp, 1},
+    {"_MazamaRollUtils_roll_completeness_cpp", (DL_FUNC) &_MazamaRollUtils_roll_completeness_cpp, 7},
+    {"_MazamaRollUtils_roll_cost_model_cpp", (DL_FUNC) &_MazamaRollUtils_roll_cost_model_cpp, 1},
+    {"_MazamaRollUtils_roll_count_cpp", (DL_FUNC) &_MazamaRollUtils_roll_count_cpp, 7},
+    {"_MazamaRollUtils_roll_ewm_cpp", (DL_FUNC) &_MazamaRollUtils_roll_ewm_cpp, 6},
+    {"_MazamaRollUtils_roll_hampel_cpp", (DL_FUNC) &_MazamaRollUtils_roll_hampel_cpp, 9},
+    {"_MazamaRollUtils_roll_hampel_clean_cpp", (DL_FUNC) &_MazamaRollUtils_roll_hampel_clean_cpp, 8},
+    {"_MazamaRollUtils_roll_MAD_cpp", (DL_FUNC) &_MazamaRollUtils_roll_MAD_cpp, 9},
+    {"_MazamaRollUtils_roll_max_cpp", (DL_FUNC) &_MazamaRollUtils_roll_max_cpp, 10},
+    {"_MazamaRollUtils_roll_mean_cpp", (DL_FUNC) &_MazamaRollUtils_roll_mean_cpp, 11},
+    {"_MazamaRollUtils_roll_median_cpp", (DL_FUNC) &_MazamaRollUtils_roll_median_cpp, 10},
+    {"_MazamaRollUtils_roll_min_cpp", (DL_FUNC) &_MazamaRollUtils_roll_min_cpp, 10},
+    {"_MazamaRollUtils_roll_prod_cpp", (DL_FUNC) &_MazamaRollUtils_roll_prod_cpp, 9},
+    {"_MazamaRollUtils_roll_multiwidth_cpp", (DL_FUNC) &_MazamaRollUtils_roll_multiwidth_cpp, 8},
+    {"_MazamaRollUtils_roll_pair_cpp", (DL_FUNC) &_MazamaRollUtils_roll_pair_cpp, 9},
+    {"_MazamaRollUtils_roll_quantile_cpp", (DL_FUNC) &_MazamaRollUtils_roll_quantile_cpp, 9},
+    {"_MazamaRollUtils_roll_sd_cpp", (DL_FUNC) &_MazamaRollUtils_roll_sd_cpp, 9},
+    {"_MazamaRollUtils_roll_sum_cpp", (DL_FUNC) &_MazamaRollUtils_roll_sum_cpp, 10},
+    {"_MazamaRollUtils_roll_var_cpp", (DL_FUNC) &_MazamaRollUtils_roll_var_cpp, 9},
     {"_MazamaRollUtils_roll_nowcast_cpp", (DL_FUNC) &_MazamaRollUtils_roll_nowcast_cpp, 1},
     {NULL, NULL, 0}
 };